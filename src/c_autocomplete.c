@@ -5057,6 +5057,7 @@ autocomplete_t autocompletelist[] =
     { "bind z +zoomin",                              DOOM1AND2 },
     { "bind z +zoomout",                             DOOM1AND2 },
     { "bindlist",                                    DOOM1AND2 },
+    { "cachesize ",                                  DOOM1AND2 },
     { "centerweapon ",                               DOOM1AND2 },
     { "centerweapon off",                            DOOM1AND2 },
     { "centerweapon on",                             DOOM1AND2 },
@@ -5988,6 +5989,7 @@ autocomplete_t autocompletelist[] =
     { "if autouse off then ",                        DOOM1AND2 },
     { "if autouse on ",                              DOOM1AND2 },
     { "if autouse on then ",                         DOOM1AND2 },
+    { "if cachesize ",                               DOOM1AND2 },
     { "if centerweapon ",                            DOOM1AND2 },
     { "if centerweapon off ",                        DOOM1AND2 },
     { "if centerweapon off then ",                   DOOM1AND2 },
@@ -6697,6 +6699,7 @@ autocomplete_t autocompletelist[] =
     { "if respawnmonsters off then ",                DOOM1AND2 },
     { "if respawnmonsters on ",                      DOOM1AND2 },
     { "if respawnmonsters on then ",                 DOOM1AND2 },
+    { "if s_cachesize ",                             DOOM1AND2 },
     { "if s_channels ",                              DOOM1AND2 },
     { "if s_channels 32 ",                           DOOM1AND2 },
     { "if s_channels 32 then ",                      DOOM1AND2 },
@@ -6707,6 +6710,16 @@ autocomplete_t autocompletelist[] =
     { "if s_musicvolume 100% then ",                 DOOM1AND2 },
     { "if s_musicvolume 67% ",                       DOOM1AND2 },
     { "if s_musicvolume 67% then ",                  DOOM1AND2 },
+    { "if s_occlusion ",                             DOOM1AND2 },
+    { "if s_occlusion off ",                         DOOM1AND2 },
+    { "if s_occlusion off then ",                    DOOM1AND2 },
+    { "if s_occlusion on ",                          DOOM1AND2 },
+    { "if s_occlusion on then ",                     DOOM1AND2 },
+    { "if s_oplmusic ",                              DOOM1AND2 },
+    { "if s_oplmusic off ",                          DOOM1AND2 },
+    { "if s_oplmusic off then ",                     DOOM1AND2 },
+    { "if s_oplmusic on ",                           DOOM1AND2 },
+    { "if s_oplmusic on then ",                      DOOM1AND2 },
     { "if s_randommusic ",                           DOOM1AND2 },
     { "if s_randommusic off ",                       DOOM1AND2 },
     { "if s_randommusic off then ",                  DOOM1AND2 },
@@ -7226,6 +7239,7 @@ autocomplete_t autocompletelist[] =
     { "melt ",                                       DOOM1AND2 },
     { "melt off",                                    DOOM1AND2 },
     { "melt on",                                     DOOM1AND2 },
+    { "memorystats",                                 DOOM1AND2 },
     { "+menu",                                       DOOM1AND2 },
     { "messages ",                                   DOOM1AND2 },
     { "messages off",                                DOOM1AND2 },
@@ -7709,6 +7723,7 @@ autocomplete_t autocompletelist[] =
     { "reset autosave",                              DOOM1AND2 },
     { "reset autotilt",                              DOOM1AND2 },
     { "reset autouse",                               DOOM1AND2 },
+    { "reset cachesize",                             DOOM1AND2 },
     { "reset centerweapon",                          DOOM1AND2 },
     { "reset con_backcolor",                         DOOM1AND2 },
     { "reset con_edgecolor",                         DOOM1AND2 },
@@ -7789,8 +7804,11 @@ autocomplete_t autocompletelist[] =
     { "reset r_supersampling",                       DOOM1AND2 },
     { "reset r_textures",                            DOOM1AND2 },
     { "reset r_translucency",                        DOOM1AND2 },
+    { "reset s_cachesize",                           DOOM1AND2 },
     { "reset s_channels",                            DOOM1AND2 },
     { "reset s_musicvolume",                         DOOM1AND2 },
+    { "reset s_occlusion",                           DOOM1AND2 },
+    { "reset s_oplmusic",                            DOOM1AND2 },
     { "reset s_randommusic",                         DOOM1AND2 },
     { "reset s_randompitch",                         DOOM1AND2 },
     { "reset s_sfxvolume",                           DOOM1AND2 },
@@ -7853,6 +7871,7 @@ autocomplete_t autocompletelist[] =
     { "+right",                                      DOOM1AND2 },
     { "+rotatemode",                                 DOOM1AND2 },
     { "+run",                                        DOOM1AND2 },
+    { "s_cachesize ",                                DOOM1AND2 },
     { "s_channels ",                                 DOOM1AND2 },
     { "s_channels 32",                               DOOM1AND2 },
     { "s_channels 64",                               DOOM1AND2 },
@@ -7860,6 +7879,12 @@ autocomplete_t autocompletelist[] =
     { "s_musicvolume 0%",                            DOOM1AND2 },
     { "s_musicvolume 100%",                          DOOM1AND2 },
     { "s_musicvolume 67%",                           DOOM1AND2 },
+    { "s_occlusion ",                                DOOM1AND2 },
+    { "s_occlusion off",                             DOOM1AND2 },
+    { "s_occlusion on",                              DOOM1AND2 },
+    { "s_oplmusic ",                                 DOOM1AND2 },
+    { "s_oplmusic off",                              DOOM1AND2 },
+    { "s_oplmusic on",                               DOOM1AND2 },
     { "s_randommusic ",                              DOOM1AND2 },
     { "s_randommusic off",                           DOOM1AND2 },
     { "s_randommusic on",                            DOOM1AND2 },
@@ -7876,6 +7901,7 @@ autocomplete_t autocompletelist[] =
     { "savegame ",                                   DOOM1AND2 },
     { "+screenshot",                                 DOOM1AND2 },
     { "skilllevel ",                                 DOOM1AND2 },
+    { "soundbenchmark",                              DOOM1AND2 },
     { "spawn ",                                      DOOM1AND2 },
     { "spawn arachnotron",                           DOOM2ONLY },
     { "spawn archvile",                              DOOM2ONLY },
@@ -8129,6 +8155,8 @@ autocomplete_t autocompletelist[] =
     { "toggle r_supersampling",                      DOOM1AND2 },
     { "toggle r_textures",                           DOOM1AND2 },
     { "toggle r_translucency",                       DOOM1AND2 },
+    { "toggle s_occlusion",                          DOOM1AND2 },
+    { "toggle s_oplmusic",                           DOOM1AND2 },
     { "toggle s_randommusic",                        DOOM1AND2 },
     { "toggle s_randompitch",                        DOOM1AND2 },
     { "toggle s_stereo",                             DOOM1AND2 },
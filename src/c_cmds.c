@@ -52,6 +52,7 @@
 #include "hu_stuff.h"
 #include "i_colors.h"
 #include "i_gamepad.h"
+#include "i_oplmusic.h"
 #include "i_system.h"
 #include "i_timer.h"
 #include "m_cheat.h"
@@ -71,6 +72,7 @@
 #include "v_video.h"
 #include "version.h"
 #include "w_wad.h"
+#include "z_zone.h"
 
 #define ALIASCMDFORMAT              ITALICS(BOLD("alias")) " [[" BOLD("\"") "]" ITALICS(BOLD("command")) "[" BOLD(";") " " ITALICS(BOLD("command")) " ..." BOLD("\"") "]]"
 #define BINDCMDFORMAT               ITALICS(BOLD("control")) " [" ITALICS(BOLD("+action")) "|[" BOLD("\"") "]" ITALICS(BOLD("command")) "[" BOLD(";") " " ITALICS(BOLD("command")) " ..." BOLD("\"") "]]"
@@ -287,6 +289,7 @@ static dboolean map_cmd_func1(char *cmd, char *parms);
 static void map_cmd_func2(char *cmd, char *parms);
 static void maplist_cmd_func2(char *cmd, char *parms);
 static void mapstats_cmd_func2(char *cmd, char *parms);
+static void memorystats_cmd_func2(char *cmd, char *parms);
 static dboolean name_cmd_func1(char *cmd, char *parms);
 static void name_cmd_func2(char *cmd, char *parms);
 static void newgame_cmd_func2(char *cmd, char *parms);
@@ -310,6 +313,7 @@ static dboolean resurrect_cmd_func1(char *cmd, char *parms);
 static void resurrect_cmd_func2(char *cmd, char *parms);
 static void save_cmd_func2(char *cmd, char *parms);
 static dboolean spawn_cmd_func1(char *cmd, char *parms);
+static void soundbenchmark_cmd_func2(char *cmd, char *parms);
 static void spawn_cmd_func2(char *cmd, char *parms);
 static dboolean take_cmd_func1(char *cmd, char *parms);
 static void take_cmd_func2(char *cmd, char *parms);
@@ -375,6 +379,7 @@ static void r_skycolor_cvar_func2(char *cmd, char *parms);
 static void r_supersampling_cvar_func2(char *cmd, char *parms);
 static void r_textures_cvar_func2(char *cmd, char *parms);
 static void r_translucency_cvar_func2(char *cmd, char *parms);
+static void s_oplmusic_cvar_func2(char *cmd, char *parms);
 static dboolean s_volume_cvars_func1(char *cmd, char *parms);
 static void s_volume_cvars_func2(char *cmd, char *parms);
 static void savegame_cvar_func2(char *cmd, char *parms);
@@ -507,6 +512,9 @@ consolecmd_t consolecmds[] =
         "Binds an " ITALICS(BOLD("+action")) " or string of " ITALICS(BOLD("commands")) " to a " ITALICS(BOLD("control")) "."),
     CCMD(bindlist, "", null_func1, bindlist_cmd_func2, false, "",
         "Lists all bound controls."),
+    CVAR_INT(cachesize, "", int_cvars_func1, int_cvars_func2, CF_NONE, NOVALUEALIAS,
+        "The amount of memory, in megabytes, used to cache lumps that are no longer in use (" BOLD("0") " for no limit, or "
+        BOLD("1") " to " BOLD("4,096") ")."),
     CVAR_BOOL(centerweapon, centreweapon, bool_cvars_func1, bool_cvars_func2, BOOLVALUEALIAS,
         "Toggles centering the player's weapon when firing."),
     CCMD(clear, "", null_func1, clear_cmd_func2, false, "",
@@ -630,6 +638,8 @@ consolecmd_t consolecmds[] =
         "Shows stats about the current map."),
     CVAR_BOOL(melt, "", bool_cvars_func1, bool_cvars_func2, BOOLVALUEALIAS,
         "Toggles a melting effect when transitioning between some screens."),
+    CCMD(memorystats, "", null_func1, memorystats_cmd_func2, false, "",
+        "Shows stats about the memory allocated by " ITALICS(PACKAGE_NAME) "."),
     CVAR_BOOL(messages, "", bool_cvars_func1, bool_cvars_func2, BOOLVALUEALIAS,
         "Toggles the display of player messages at the top of the screen."),
     CVAR_BOOL(mouselook, "", bool_cvars_func1, mouselook_cvar_func2, BOOLVALUEALIAS,
@@ -765,10 +775,17 @@ consolecmd_t consolecmds[] =
         "Restarts the current map."),
     CCMD(resurrect, "", resurrect_cmd_func1, resurrect_cmd_func2, true, RESURRECTCMDFORMAT,
         "Resurrects the " BOLD("player") ", " BOLD("all") " monsters or a type of " ITALICS(BOLD("monster")) "."),
+    CVAR_INT(s_cachesize, "", int_cvars_func1, int_cvars_func2, CF_NONE, NOVALUEALIAS,
+        "The amount of memory, in megabytes, used to cache sound effects (" BOLD("0") " for no limit, or " BOLD("1") " to "
+        BOLD("1,024") ")."),
     CVAR_INT(s_channels, "", int_cvars_func1, int_cvars_func2, CF_NONE, NOVALUEALIAS,
         "The number of sound effects that can be played at the same time (" BOLD("8") " to " BOLD("64") ")."),
     CVAR_INT(s_musicvolume, "", s_volume_cvars_func1, s_volume_cvars_func2, CF_PERCENT, NOVALUEALIAS,
         "The volume level of music (" BOLD("0%") " to " BOLD("100%") ")."),
+    CVAR_BOOL(s_occlusion, "", bool_cvars_func1, bool_cvars_func2, BOOLVALUEALIAS,
+        "Toggles muffling sound effects from sectors the player can't see into."),
+    CVAR_BOOL(s_oplmusic, "", bool_cvars_func1, s_oplmusic_cvar_func2, BOOLVALUEALIAS,
+        "Toggles playing MUS music with a built-in OPL synthesizer, rather than converting it to MIDI."),
     CVAR_BOOL(s_randommusic, "", bool_cvars_func1, bool_cvars_func2, BOOLVALUEALIAS,
         "Toggles randomizing the music at the start of each map."),
     CVAR_BOOL(s_randompitch, "", bool_cvars_func1, bool_cvars_func2, BOOLVALUEALIAS,
@@ -784,6 +801,8 @@ consolecmd_t consolecmds[] =
         "The currently selected savegame in the menu (" BOLD("1") " to " BOLD("6") ")."),
     CVAR_INT(skilllevel, "", int_cvars_func1, skilllevel_cvar_func2, CF_NONE, NOVALUEALIAS,
         "The currently selected skill level in the menu (" BOLD("1") " to " BOLD("5") ")."),
+    CCMD(soundbenchmark, "", null_func1, soundbenchmark_cmd_func2, false, "",
+        "Times starting and stopping sound effects on all the channels."),
     CCMD(spawn, summon, spawn_cmd_func1, spawn_cmd_func2, true, SPAWNCMDFORMAT,
         "Spawns an " ITALICS(BOLD("item")) " or " ITALICS(BOLD("monster")) " in front of the player."),
     CVAR_INT(stillbob, "", int_cvars_func1, int_cvars_func2, CF_PERCENT, NOVALUEALIAS,
@@ -3992,7 +4011,12 @@ static void mapstats_cmd_func2(char *cmd, char *parms)
             C_TabbedOutput(tabs, "   Composer\t%s", "Bobby Prince");
 
         if (musmusictype)
+        {
             C_TabbedOutput(tabs, "   Format\tMUS");
+
+            if (oplmusictype)
+                C_TabbedOutput(tabs, "   Synthesizer\tOPL (%.2fms per second)", I_OPLRenderTime());
+        }
         else if (midimusictype || musictype == MUS_MID)
             C_TabbedOutput(tabs, "   Format\tMIDI");
         else if (musictype == MUS_OGG)
@@ -4008,6 +4032,64 @@ static void mapstats_cmd_func2(char *cmd, char *parms)
     }
 }
 
+//
+// memorystats CCMD
+//
+static void memorystats_cmd_func2(char *cmd, char *parms)
+{
+    const int   tabs[3] = { 100, 220, 0 };
+    const char  *tagnames[PU_MAX] = { "", "Static", "Map", "Map specials", "Cache", "Released" };
+    size_t      totalbytes = 0;
+    size_t      totalpeak = 0;
+    int         purges;
+    char        *temp1;
+    char        *temp2;
+    char        *temp3;
+
+    for (int tag = PU_STATIC; tag < PU_MAX; tag++)
+    {
+        const zonestats_t   *stats = &zonestats[tag];
+
+        temp1 = commify(stats->blocks);
+        temp2 = commify((int64_t)(stats->bytes + 1023) / 1024);
+        temp3 = commify((int64_t)(stats->peakbytes + 1023) / 1024);
+        C_TabbedOutput(tabs, "%s\t%s block%s\t%s KB  (peak of %s KB)",
+            tagnames[tag], temp1, (stats->blocks == 1 ? "" : "s"), temp2, temp3);
+        free(temp1);
+        free(temp2);
+        free(temp3);
+
+        totalbytes += stats->bytes;
+        totalpeak += stats->peakbytes;
+    }
+
+    temp1 = commify((int64_t)(totalbytes + 1023) / 1024);
+    temp2 = commify((int64_t)(totalpeak + 1023) / 1024);
+    C_TabbedOutput(tabs, "Total\t\t%s KB  (peak of %s KB)", temp1, temp2);
+    free(temp1);
+    free(temp2);
+
+    temp1 = commify(lumpcachehits);
+    temp2 = commify(lumpcachemisses);
+    purges = zonestats[PU_CACHE].purges + zonestats[PU_RELEASED].purges;
+    temp3 = commify(purges);
+    C_TabbedOutput(tabs, "Lump cache\t%s hit%s\t%s miss%s, %s purge%s",
+        temp1, (lumpcachehits == 1 ? "" : "s"), temp2, (lumpcachemisses == 1 ? "" : "es"),
+        temp3, (purges == 1 ? "" : "s"));
+    free(temp1);
+    free(temp2);
+    free(temp3);
+
+    temp1 = commify(sfxcachehits);
+    temp2 = commify(sfxcachemisses);
+    temp3 = commify((int64_t)(sfxcachebytes + 1023) / 1024);
+    C_TabbedOutput(tabs, "Sound cache\t%s hit%s\t%s miss%s, %s KB",
+        temp1, (sfxcachehits == 1 ? "" : "s"), temp2, (sfxcachemisses == 1 ? "" : "es"), temp3);
+    free(temp1);
+    free(temp2);
+    free(temp3);
+}
+
 //
 // name CCMD
 //
@@ -6241,6 +6323,29 @@ static void save_cmd_func2(char *cmd, char *parms)
     G_SaveGame(-1, "", buffer);
 }
 
+//
+// soundbenchmark CCMD
+//
+#define SOUNDBENCHMARKCOUNT 1000000
+
+static void soundbenchmark_cmd_func2(char *cmd, char *parms)
+{
+    double  time;
+    char    *temp;
+
+    if (nosfx)
+    {
+        C_Warning(0, "Sound effects have been disabled.");
+        return;
+    }
+
+    time = S_StressChannels(SOUNDBENCHMARKCOUNT);
+    temp = commify(SOUNDBENCHMARKCOUNT);
+    C_Output("%s sound effects were started on %i channels in %.2fms, or %.0fns each.",
+        temp, s_channels, time, time * 1000000.0 / SOUNDBENCHMARKCOUNT);
+    free(temp);
+}
+
 //
 // spawn CCMD
 //
@@ -8597,6 +8702,20 @@ static void r_translucency_cvar_func2(char *cmd, char *parms)
     }
 }
 
+//
+// s_oplmusic CVAR
+//
+static void s_oplmusic_cvar_func2(char *cmd, char *parms)
+{
+    const dboolean  s_oplmusic_old = s_oplmusic;
+
+    bool_cvars_func2(cmd, parms);
+
+    // restart the current music with the new synthesizer
+    if (s_oplmusic != s_oplmusic_old && mus_playing && musmusictype)
+        S_ChangeMusic((int)(mus_playing - S_music), true, true, false);
+}
+
 //
 // s_musicvolume and s_sfxvolume CVARs
 //
@@ -155,6 +155,7 @@ char            *previouswad;
 dboolean        devparm;                // started game with -devparm
 dboolean        fastparm;               // checkparm of -fast
 dboolean        freeze;
+dboolean        headless;               // checkparm of -headless
 dboolean        nomonsters;             // checkparm of -nomonsters
 dboolean        pistolstart;            // [BH] checkparm of -pistolstart
 dboolean        regenhealth;
@@ -179,6 +180,50 @@ dboolean        splashscreen = true;
 
 static int      startuptimer;
 
+// The stages of startup that are run once all WADs have been loaded. Each
+// stage runs once every stage it depends on has completed. Stages that
+// only compute tables (and so don't touch the zone or the WADs) can run
+// in the background on their own thread, alongside the stages after them.
+typedef struct
+{
+    char            *name;
+    void            (*func)(void);
+    int             dependencies;
+    dboolean        background;
+    SDL_Thread      *thread;
+    int             start;
+    int             end;
+} startupstage_t;
+
+enum
+{
+    STAGE_M_INIT,
+    STAGE_R_INIT,
+    STAGE_R_INITDISTORTEDFLATS,
+    STAGE_P_INIT,
+    STAGE_S_INIT,
+    STAGE_HU_INIT,
+    STAGE_ST_INIT,
+    STAGE_AM_INIT,
+    STAGE_C_INIT,
+    NUMSTARTUPSTAGES
+};
+
+#define STAGE(stage)    (1 << (stage))
+
+static startupstage_t   startupstages[NUMSTARTUPSTAGES] =
+{
+    { "M_Init",               &M_Init,               0,                   false },
+    { "R_Init",               &R_Init,               0,                   false },
+    { "R_InitDistortedFlats", &R_InitDistortedFlats, STAGE(STAGE_R_INIT), true  },
+    { "P_Init",               &P_Init,               STAGE(STAGE_R_INIT), false },
+    { "S_Init",               &S_Init,               0,                   false },
+    { "HU_Init",              &HU_Init,              0,                   false },
+    { "ST_Init",              &ST_Init,              0,                   false },
+    { "AM_Init",              &AM_Init,              0,                   false },
+    { "C_Init",               &C_Init,               0,                   false }
+};
+
 dboolean        realframe;
 static dboolean error;
 
@@ -1139,7 +1184,7 @@ static int D_OpenWADLauncher(void)
     M_StringCopy(szFile, wad, sizeof(szFile));
     ofn.lpstrFile = szFile;
     ofn.nMaxFile = sizeof(szFile);
-    ofn.lpstrFilter = "IWAD and/or PWAD(s) (*.wad)\0*.WAD;*.DEH;*.BEX;*.CFG\0";
+    ofn.lpstrFilter = "IWAD and/or PWAD(s) (*.wad, *.pk3)\0*.WAD;*.PK3;*.DEH;*.BEX;*.CFG\0";
     ofn.nFilterIndex = 1;
     ofn.lpstrFileTitle = NULL;
     ofn.nMaxFileTitle = 0;
@@ -1826,6 +1871,64 @@ static void D_ParseStartupString(const char *string)
         }
 }
 
+// Run a background startup stage on its own thread, and note when it ended.
+static int D_StartupStageThread(void *data)
+{
+    startupstage_t  *stage = data;
+
+    stage->func();
+    stage->end = I_GetTimeMS();
+
+    return 0;
+}
+
+static void D_FinishStartupStage(startupstage_t *stage)
+{
+    if (stage->thread)
+    {
+        SDL_WaitThread(stage->thread, NULL);
+        stage->thread = NULL;
+    }
+}
+
+//
+// D_RunStartupStages
+// Run each stage in order, starting background stages on their own thread
+// and waiting for any that a stage depends on before running it.
+//
+static void D_RunStartupStages(void)
+{
+    for (int i = 0; i < NUMSTARTUPSTAGES; i++)
+    {
+        startupstage_t  *stage = &startupstages[i];
+
+        for (int j = 0; j < i; j++)
+            if (stage->dependencies & STAGE(j))
+                D_FinishStartupStage(&startupstages[j]);
+
+        stage->start = I_GetTimeMS();
+
+        if (!stage->background || !(stage->thread = SDL_CreateThread(&D_StartupStageThread, stage->name, stage)))
+        {
+            stage->func();
+            stage->end = I_GetTimeMS();
+        }
+    }
+
+    for (int i = 0; i < NUMSTARTUPSTAGES; i++)
+        D_FinishStartupStage(&startupstages[i]);
+
+    // show the timeline of each stage when -devparm is used
+    if (devparm)
+        for (int i = 0; i < NUMSTARTUPSTAGES; i++)
+        {
+            startupstage_t  *stage = &startupstages[i];
+
+            C_Output(BOLD("%s") " ran%s from %ims to %ims (%ims).", stage->name, (stage->background ? " in the background" : ""),
+                stage->start - startuptimer, stage->end - startuptimer, stage->end - stage->start);
+        }
+}
+
 //
 // D_DoomMainSetup
 //
@@ -1900,6 +2003,10 @@ static void D_DoomMainSetup(void)
     if ((devparm = M_CheckParm("-devparm")))
         C_Output("A " BOLD("-devparm") " parameter was found on the command-line. %s", s_D_DEVSTR);
 
+    if ((headless = M_CheckParm("-headless")))
+        C_Output("A " BOLD("-headless") " parameter was found on the command-line. Nothing will be shown on the screen or heard "
+            "through the speakers, but the game will still run.");
+
     // turbo option
     if ((p = M_CheckParm("-turbo")))
     {
@@ -2293,21 +2400,7 @@ static void D_DoomMainSetup(void)
         }
     }
 
-    M_Init();
-
-    R_Init();
-
-    P_Init();
-
-    S_Init();
-
-    HU_Init();
-
-    ST_Init();
-
-    AM_Init();
-
-    C_Init();
+    D_RunStartupStages();
 
     if ((startloadgame = ((p = M_CheckParmWithArgs("-loadgame", 1, 1)) ? atoi(myargv[p + 1]) : -1)) >= 0 && startloadgame <= 5)
     {
@@ -2393,7 +2486,7 @@ static void D_DoomMainSetup(void)
             C_Output("Warping to %s...", lumpname);
             G_DeferredInitNew(startskill, startepisode, startmap);
         }
-        else if (M_CheckParm("-nosplash"))
+        else if (M_CheckParm("-nosplash") || headless)
         {
             menuactive = false;
             splashscreen = false;
@@ -2409,9 +2502,18 @@ static void D_DoomMainSetup(void)
     }
 
     seconds = striptrailingzero((I_GetTimeMS() - startuptimer) / 1000.0f, 1);
-    C_Output("Startup took %s second%s to complete.", seconds, (M_StringCompare(seconds, "1") ? "" : "s"));
+    C_Output("Startup took %s second%s to complete%s.", seconds, (M_StringCompare(seconds, "1") ? "" : "s"),
+        (cachemisses ? " while updating the startup cache" : (cachehits ? " using the startup cache" : "")));
     free(seconds);
 
+    if (W_MappedLumpSize())
+    {
+        char    *temp = commify((int64_t)(W_MappedLumpSize() + 1023) / 1024);
+
+        C_Output("%s KB of lumps are being used directly from memory-mapped WADs rather than being copied into memory.", temp);
+        free(temp);
+    }
+
     // Ty 04/08/98 - Add 5 lines of misc. data, only if non-blank
     // The expectation is that these will be set in a .bex file
     if ((*startup1 || *startup2 || *startup3 || *startup4 || *startup5) && !FREEDOOM)
@@ -59,6 +59,7 @@ extern dboolean         pistolstart;            // [BH] checkparm of -pistolstar
 extern dboolean         fastparm;               // checkparm of -fast
 
 extern dboolean         devparm;                // DEBUG: launched with -devparm
+extern dboolean         headless;               // checkparm of -headless
 
 // -----------------------------------------------------
 // Game Mode - identify IWAD as shareware, retail etc.
@@ -869,7 +869,7 @@ static void F_CastDrawer(void)
         rot = castrot;
 
     lump = sprframe->lump[rot];
-    patch = W_CacheLumpNum(lump + firstspritelump);
+    patch = W_CacheLumpNumWritable(lump + firstspritelump);
     patch->topoffset = (r_fixspriteoffsets ? newspritetopoffset[lump] : spritetopoffset[lump]) >> FRACBITS;
 
     if (type == MT_SKULL)
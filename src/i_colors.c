@@ -41,6 +41,7 @@
 #include "i_colors.h"
 #include "i_swap.h"
 #include "i_video.h"
+#include "m_misc.h"
 #include "v_video.h"
 #include "w_wad.h"
 #include "z_zone.h"
@@ -263,10 +264,8 @@ int FindDominantEdgeColor(patch_t *patch)
     return color;
 }
 
-static byte *GenerateTintTable(byte *palette, int percent, int colors)
+static void GenerateTintTable(byte *result, byte *palette, int percent, int colors)
 {
-    byte    *result = malloc(256 * 256);
-
     for (int foreground = 0; foreground < 256; foreground++)
         if ((filter[foreground] & colors) || colors == ALL || colors == ALTHUD)
             for (int background = 0; background < 256; background++)
@@ -288,14 +287,10 @@ static byte *GenerateTintTable(byte *palette, int percent, int colors)
         else
             for (int background = 0; background < 256; background++)
                 result[(background << 8) + foreground] = foreground;
-
-    return result;
 }
 
-static byte *GenerateAdditiveTintTable(byte *palette, int colors)
+static void GenerateAdditiveTintTable(byte *result, byte *palette, int colors)
 {
-    byte    *result = malloc(256 * 256);
-
     for (int foreground = 0; foreground < 256; foreground++)
         if ((filter[foreground] & colors) || colors == ALL)
             for (int background = 0; background < 256; background++)
@@ -311,44 +306,76 @@ static byte *GenerateAdditiveTintTable(byte *palette, int colors)
         else
             for (int background = 0; background < 256; background++)
                 result[(background << 8) + foreground] = foreground;
-
-    return result;
 }
 
+#define ADDITIVE    -1
+
+static struct
+{
+    byte    **table;
+    int     percent;
+    int     colors;
+} tinttabs[] =
+{
+    { &tinttab10,         10,       ALL },
+    { &tinttab15,         15,       ALL },
+    { &tinttab20,         20,       ALL },
+    { &tinttab25,         25,       ALL },
+    { &tinttab30,         30,       ALL },
+    { &tinttab33,         33,       ALL },
+    { &tinttab40,         40,       ALL },
+    { &tinttab50,         50,       ALL },
+    { &tinttab60,         60,       ALL },
+    { &tinttab66,         66,       ALL },
+    { &tinttab70,         70,       ALL },
+    { &tinttab75,         75,       ALL },
+    { &tinttab80,         80,       ALL },
+    { &tinttab90,         90,       ALL },
+    { &alttinttab20,      20,       ALTHUD },
+    { &alttinttab40,      40,       ALTHUD },
+    { &alttinttab60,      60,       ALTHUD },
+    { &tinttabadditive,   ADDITIVE, ALL },
+    { &tinttabred,        ADDITIVE, REDS },
+    { &tinttabredwhite1,  ADDITIVE, (REDS | WHITES) },
+    { &tinttabredwhite2,  ADDITIVE, (REDS | WHITES | EXTRAS) },
+    { &tinttabgreen,      ADDITIVE, GREENS },
+    { &tinttabblue,       ADDITIVE, BLUES },
+    { &tinttabred33,      33,       REDS },
+    { &tinttabredwhite50, 50,       (REDS | WHITES) },
+    { &tinttabgreen33,    33,       GREENS },
+    { &tinttabblue25,     25,       BLUES }
+};
+
+#define NUMTINTTABS arrlen(tinttabs)
+
 void I_InitTintTables(byte *palette)
 {
-    int lump = W_CheckNumForName("TRANMAP");
-
-    tinttab10 = GenerateTintTable(palette, 10, ALL);
-    tinttab15 = GenerateTintTable(palette, 15, ALL);
-    tinttab20 = GenerateTintTable(palette, 20, ALL);
-    tinttab25 = GenerateTintTable(palette, 25, ALL);
-    tinttab30 = GenerateTintTable(palette, 30, ALL);
-    tinttab33 = GenerateTintTable(palette, 33, ALL);
-    tinttab40 = GenerateTintTable(palette, 40, ALL);
-    tinttab50 = GenerateTintTable(palette, 50, ALL);
-    tinttab60 = GenerateTintTable(palette, 60, ALL);
-    tinttab66 = GenerateTintTable(palette, 66, ALL);
-    tinttab70 = GenerateTintTable(palette, 70, ALL);
-    tinttab75 = GenerateTintTable(palette, 75, ALL);
-    tinttab80 = GenerateTintTable(palette, 80, ALL);
-    tinttab90 = GenerateTintTable(palette, 90, ALL);
-
-    alttinttab20 = GenerateTintTable(palette, 20, ALTHUD);
-    alttinttab40 = GenerateTintTable(palette, 40, ALTHUD);
-    alttinttab60 = GenerateTintTable(palette, 60, ALTHUD);
+    int             lump = W_CheckNumForName("TRANMAP");
+    const size_t    length = NUMTINTTABS * 256 * 256;
+    byte            *tables = malloc(length);
 
-    tranmap = (lump != -1 ? W_CacheLumpNum(lump) : tinttab50);
+    // The tables only depend on the palette, so they are read from the
+    // startup cache if they have already been generated from this one.
+    const uint64_t  key = M_HashData(palette, 256 * 3, 0);
+    const dboolean  cached = M_ReadCacheFile("tinttabs", key, tables, length);
+
+    for (int i = 0; i < (int)NUMTINTTABS; i++)
+    {
+        byte    *table = tables + ((size_t)i << 16);
+
+        if (!cached)
+        {
+            if (tinttabs[i].percent == ADDITIVE)
+                GenerateAdditiveTintTable(table, palette, tinttabs[i].colors);
+            else
+                GenerateTintTable(table, palette, tinttabs[i].percent, tinttabs[i].colors);
+        }
+
+        *tinttabs[i].table = table;
+    }
 
-    tinttabadditive = GenerateAdditiveTintTable(palette, ALL);
-    tinttabred = GenerateAdditiveTintTable(palette, REDS);
-    tinttabredwhite1 = GenerateAdditiveTintTable(palette, (REDS | WHITES));
-    tinttabredwhite2 = GenerateAdditiveTintTable(palette, (REDS | WHITES | EXTRAS));
-    tinttabgreen = GenerateAdditiveTintTable(palette, GREENS);
-    tinttabblue = GenerateAdditiveTintTable(palette, BLUES);
-
-    tinttabred33 = GenerateTintTable(palette, 33, REDS);
-    tinttabredwhite50 = GenerateTintTable(palette, 50, (REDS | WHITES));
-    tinttabgreen33 = GenerateTintTable(palette, 33, GREENS);
-    tinttabblue25 = GenerateTintTable(palette, 25, BLUES);
+    if (!cached)
+        M_WriteCacheFile("tinttabs", key, tables, length);
+
+    tranmap = (lump != -1 ? W_CacheLumpNum(lump) : tinttab50);
 }
@@ -42,14 +42,22 @@
 
 #include "c_console.h"
 #include "i_midirpc.h"
+#include "i_oplmusic.h"
+#include "m_config.h"
 #include "mmus2mid.h"
 #include "s_sound.h"
 
 dboolean        midimusictype;
 dboolean        musmusictype;
+dboolean        oplmusictype;
 
 static dboolean music_initialized;
 
+// the MUS to MIDI conversion buffers are kept from one song to the next
+static MIDI     mididata;
+static uint8_t  *mid;
+static size_t   midsize;
+
 static int      current_music_volume;
 static int      paused_midi_volume;
 
@@ -64,6 +72,7 @@ void I_ShutdownMusic(void)
     if (!music_initialized)
         return;
 
+    I_OPLStopSong();
     Mix_FadeOutMusic(500);
     while (Mix_PlayingMusic());
     music_initialized = false;
@@ -71,6 +80,11 @@ void I_ShutdownMusic(void)
     if (mus_playing)
         I_UnRegisterSong(mus_playing->handle);
 
+    FreeMIDIData(&mididata);
+    free(mid);
+    mid = NULL;
+    midsize = 0;
+
     Mix_CloseAudio();
     SDL_QuitSubSystem(SDL_INIT_AUDIO);
 
@@ -120,6 +134,8 @@ void I_SetMusicVolume(int volume)
     // Internal state variable.
     current_music_volume = volume;
 
+    I_OPLSetVolume(current_music_volume);
+
 #if defined(_WIN32)
     // adjust server volume
     if (serverMidiPlaying)
@@ -138,6 +154,12 @@ void I_PlaySong(void *handle, dboolean looping)
     if (!music_initialized)
         return;
 
+    if (oplmusictype)
+    {
+        I_OPLPlaySong(looping);
+        return;
+    }
+
 #if defined(_WIN32)
     if (serverMidiPlaying)
     {
@@ -152,11 +174,30 @@ void I_PlaySong(void *handle, dboolean looping)
         Mix_PlayMusic(handle, (looping ? -1 : 1));
 }
 
+// Start playing a song, fading it in over ms milliseconds
+void I_FadeInSong(void *handle, dboolean looping, int ms)
+{
+    if (!music_initialized)
+        return;
+
+    // the OPL synthesizer and MIDI server don't return a handle, and can't fade
+    if (handle)
+        Mix_FadeInMusic(handle, (looping ? -1 : 1), ms);
+    else
+        I_PlaySong(handle, looping);
+}
+
 void I_PauseSong(void)
 {
     if (!music_initialized)
         return;
 
+    if (oplmusictype)
+    {
+        I_OPLPauseSong(true);
+        return;
+    }
+
 #if defined(_WIN32)
     if (serverMidiPlaying)
     {
@@ -179,6 +220,12 @@ void I_ResumeSong(void)
     if (!music_initialized)
         return;
 
+    if (oplmusictype)
+    {
+        I_OPLPauseSong(false);
+        return;
+    }
+
 #if defined(_WIN32)
     if (serverMidiPlaying)
     {
@@ -198,6 +245,12 @@ void I_StopSong(void)
     if (!music_initialized)
         return;
 
+    if (oplmusictype)
+    {
+        I_OPLStopSong();
+        return;
+    }
+
 #if defined(_WIN32)
     if (serverMidiPlaying)
     {
@@ -241,6 +294,7 @@ void *I_RegisterSong(void *data, int size)
 
         midimusictype = false;
         musmusictype = false;
+        oplmusictype = false;
 
         // Check for MIDI or MUS format first:
         if (size >= 14)
@@ -249,21 +303,22 @@ void *I_RegisterSong(void *data, int size)
                 midimusictype = true;
             else if (mmuscheckformat((uint8_t *)data, size))    // is it a MUS?
             {
-                MIDI    mididata;
-                uint8_t *mid;
-                int     midlen;
+                int midlen;
 
                 musmusictype = true;
 
-                memset(&mididata, 0, sizeof(MIDI));
+                // play it with the OPL synthesizer if selected
+                if (s_oplmusic && I_OPLRegisterSong(data, size))
+                {
+                    oplmusictype = true;
+                    return NULL;
+                }
 
                 if (!mmus2mid((uint8_t *)data, (size_t)size, &mididata))
                     return NULL;
 
                 // Hurrah! Let's make it a mid and give it to SDL_mixer
-                MIDIToMidi(&mididata, &mid, &midlen);
-
-                FreeMIDIData(&mididata);
+                MIDIToMidi(&mididata, &mid, &midsize, &midlen);
 
                 data = mid;
                 size = midlen;
@@ -287,3 +342,33 @@ void *I_RegisterSong(void *data, int size)
         return music;
     }
 }
+
+// Register a song so it can be cached for later, without disturbing the song
+// that's playing. Songs the OPL synthesizer or MIDI server would play aren't
+// loaded, as they can only hold the song that's playing.
+void *I_PrecacheSong(void *data, int size, dboolean *midi, dboolean *mus)
+{
+    const dboolean  midimusictype_old = midimusictype;
+    const dboolean  musmusictype_old = musmusictype;
+    const dboolean  oplmusictype_old = oplmusictype;
+    const dboolean  ismus = (size >= 14 && mmuscheckformat((uint8_t *)data, size));
+    void            *handle;
+
+    if (!music_initialized || (ismus && s_oplmusic))
+        return NULL;
+
+#if defined(_WIN32)
+    if (midirpc && (ismus || (size >= 14 && !memcmp(data, "MThd", 4))))
+        return NULL;
+#endif
+
+    handle = I_RegisterSong(data, size);
+    *midi = midimusictype;
+    *mus = musmusictype;
+
+    midimusictype = midimusictype_old;
+    musmusictype = musmusictype_old;
+    oplmusictype = oplmusictype_old;
+
+    return handle;
+}
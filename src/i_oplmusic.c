@@ -0,0 +1,768 @@
+/*
+========================================================================
+
+                           D O O M  R e t r o
+         The classic, refined DOOM source port. For Windows PC.
+
+========================================================================
+
+  Copyright © 1993-2021 by id Software LLC, a ZeniMax Media company.
+  Copyright © 2013-2021 by Brad Harding <mailto:brad@doomretro.com>.
+
+  DOOM Retro is a fork of Chocolate DOOM. For a list of credits, see
+  <https://github.com/bradharding/doomretro/wiki/CREDITS>.
+
+  This file is a part of DOOM Retro.
+
+  DOOM Retro is free software: you can redistribute it and/or modify it
+  under the terms of the GNU General Public License as published by the
+  Free Software Foundation, either version 3 of the License, or (at your
+  option) any later version.
+
+  DOOM Retro is distributed in the hope that it will be useful, but
+  WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with DOOM Retro. If not, see <https://www.gnu.org/licenses/>.
+
+  DOOM is a registered trademark of id Software LLC, a ZeniMax Media
+  company, in the US and/or other countries, and is used without
+  permission. All other trademarks are the property of their respective
+  holders. DOOM Retro is in no way affiliated with nor endorsed by
+  id Software.
+
+========================================================================
+*/
+
+#include <math.h>
+#include <string.h>
+
+#include "SDL.h"
+#include "SDL_mixer.h"
+
+#include "doomstat.h"
+#include "i_oplmusic.h"
+#include "i_swap.h"
+#include "m_fixed.h"
+#include "w_wad.h"
+
+//
+// A small software FM synthesizer, modeled on the 2-operator voices of the OPL3
+// chip the original game used on AdLib and Sound Blaster cards. MUS lumps are
+// sequenced directly, using the instruments in the GENMIDI lump, and rendered
+// into SDL_mixer's music hook on the audio thread, so no MIDI conversion or
+// external MIDI synthesizer is needed.
+//
+// Only what affects how the music sounds is emulated: operator phase
+// modulation and feedback, the four OPL2 waveforms, and the attack, decay,
+// sustain and release envelope. Tremolo, vibrato and key scaling are ignored.
+//
+
+#define GENMIDI_HEADER          "#OPL_II#"
+#define GENMIDI_NUMINSTRS       175
+#define GENMIDI_FLAG_FIXED      0x0001
+#define GENMIDI_FLAG_2VOICE     0x0004
+
+#define OPL_NUMVOICES           18
+#define OPL_SINEBITS            10
+#define OPL_SINESIZE            (1 << OPL_SINEBITS)
+#define OPL_MAXATTENUATION      511
+#define OPL_TICKRATE            140
+
+#define MUS_NUMCHANNELS         16
+#define MUS_PERCUSSIONCHANNEL   15
+#define MUS_FIRSTPERCUSSION     35
+#define MUS_LASTPERCUSSION      81
+
+#if defined(_MSC_VER) || defined(__GNUC__)
+#pragma pack(push, 1)
+#endif
+
+typedef struct
+{
+    byte            tremolo;
+    byte            attack;
+    byte            sustain;
+    byte            waveform;
+    byte            scale;
+    byte            level;
+} PACKEDATTR genmidi_op_t;
+
+typedef struct
+{
+    genmidi_op_t    modulator;
+    byte            feedback;
+    genmidi_op_t    carrier;
+    byte            unused;
+    short           basenoteoffset;
+} PACKEDATTR genmidi_voice_t;
+
+typedef struct
+{
+    unsigned short  flags;
+    byte            finetuning;
+    byte            fixednote;
+    genmidi_voice_t voices[2];
+} PACKEDATTR genmidi_instr_t;
+
+#if defined(_MSC_VER) || defined(__GNUC__)
+#pragma pack(pop)
+#endif
+
+enum
+{
+    ENV_OFF,
+    ENV_ATTACK,
+    ENV_DECAY,
+    ENV_SUSTAIN,
+    ENV_RELEASE
+};
+
+typedef struct
+{
+    uint32_t        phase;
+    uint32_t        phaseinc;
+    int             multiplier;         // frequency multiplier, times 2
+    int             waveform;
+    int             env;                // attenuation, in 16.16 OPL units of 0.1875 dB
+    int             state;
+    int             attackrate;
+    int             decayrate;
+    int             sustainlevel;
+    int             releaserate;
+    dboolean        sustaining;
+    int             level;              // total level plus note volume
+    int             totallevel;
+    int             out;
+    int             prevout;
+} opl_operator_t;
+
+typedef struct
+{
+    opl_operator_t  modulator;
+    opl_operator_t  carrier;
+    int             feedback;
+    dboolean        additive;
+    int             channel;
+    int             key;
+    int             note;
+    int             finetune;           // in 1/32 semitones
+    int             velocity;
+    int             leftgain;
+    int             rightgain;
+    dboolean        keyon;
+    dboolean        active;
+    unsigned int    age;
+} opl_voice_t;
+
+typedef struct
+{
+    int             instrument;
+    int             volume;
+    int             pan;
+    int             bend;               // in 1/32 semitones
+    int             notevolume;
+} opl_channel_t;
+
+static const genmidi_instr_t    *instrs;
+
+static int          oplrate;
+static int16_t      waveforms[4][OPL_SINESIZE];
+static int          exptable[OPL_MAXATTENUATION + 1];
+static int          volumetable[128];
+static int          attackrates[16];
+static int          decayrates[16];
+
+static opl_voice_t      voices[OPL_NUMVOICES];
+static opl_channel_t    channels[MUS_NUMCHANNELS];
+static unsigned int     voiceage;
+
+static const byte   *score;
+static int          scorelength;
+static int          scorepos;
+static int64_t      waitsamples;        // samples until the next event, in 16.16
+static int          samplespertick;     // in 16.16
+
+static dboolean     songplaying;
+static dboolean     songpaused;
+static dboolean     songlooping;
+static int          volume = MIX_MAX_VOLUME;
+
+static uint64_t     rendertime;
+static uint64_t     renderedsamples;
+
+static void InitTables(void)
+{
+    for (int i = 0; i < OPL_SINESIZE; i++)
+    {
+        const int   value = (int)(sin((i + 0.5) * 2.0 * M_PI / OPL_SINESIZE) * 4095.0);
+
+        waveforms[0][i] = value;
+        waveforms[1][i] = MAX(0, value);
+        waveforms[2][i] = ABS(value);
+        waveforms[3][i] = ((i & (OPL_SINESIZE / 4)) ? 0 : ABS(value));
+    }
+
+    for (int i = 0; i <= OPL_MAXATTENUATION; i++)
+        exptable[i] = (int)(4096.0 * pow(2.0, -i / 32.0));
+
+    exptable[OPL_MAXATTENUATION] = 0;
+
+    // volume as attenuation, 6 dB every 32 units
+    volumetable[0] = OPL_MAXATTENUATION;
+
+    for (int i = 1; i < 128; i++)
+        volumetable[i] = MIN((int)(-log2(i / 127.0) * 32.0), OPL_MAXATTENUATION);
+
+    // the OPL's attack and decay times, halving with each rate
+    attackrates[0] = 0;
+    decayrates[0] = 0;
+
+    for (int i = 1; i < 16; i++)
+    {
+        const double    attacksamples = 2826.24 / (1 << (i - 1)) * oplrate / 1000.0;
+        const double    decaysamples = 39280.64 / (1 << (i - 1)) * oplrate / 1000.0;
+
+        // the attack is exponential, reaching full volume after about 6.24 time constants
+        attackrates[i] = (i == 15 || attacksamples < 6.24 ? 65536 : (int)(65536.0 * 6.24 / attacksamples));
+        decayrates[i] = (int)((OPL_MAXATTENUATION << 16) / MAX(1.0, decaysamples));
+    }
+}
+
+static dboolean LoadInstruments(void)
+{
+    const int   lumpnum = W_CheckNumForName("GENMIDI");
+    byte        *data;
+
+    if (instrs)
+        return true;
+
+    if (lumpnum < 0 || W_LumpLength(lumpnum) < 8 + GENMIDI_NUMINSTRS * (int)sizeof(genmidi_instr_t))
+        return false;
+
+    data = W_CacheLumpNum(lumpnum);
+
+    if (memcmp(data, GENMIDI_HEADER, 8))
+    {
+        W_ReleaseLumpNum(lumpnum);
+        return false;
+    }
+
+    // the lump stays locked for as long as the game runs
+    instrs = (const genmidi_instr_t *)(data + 8);
+    return true;
+}
+
+static void SetVoiceFrequency(opl_voice_t *voice)
+{
+    const double    note = voice->note + (channels[voice->channel].bend + voice->finetune) / 32.0;
+    const double    frequency = 440.0 * pow(2.0, (note - 69.0) / 12.0);
+    const double    phaseinc = frequency * 4294967296.0 / oplrate / 2.0;
+
+    voice->modulator.phaseinc = (uint32_t)(phaseinc * voice->modulator.multiplier);
+    voice->carrier.phaseinc = (uint32_t)(phaseinc * voice->carrier.multiplier);
+}
+
+static void SetVoiceVolume(opl_voice_t *voice)
+{
+    const opl_channel_t *channel = &channels[voice->channel];
+    const int           attenuation = volumetable[voice->velocity * channel->volume / 127];
+
+    voice->carrier.level = voice->carrier.totallevel + attenuation;
+    voice->modulator.level = voice->modulator.totallevel + (voice->additive ? attenuation : 0);
+}
+
+static void SetVoicePan(opl_voice_t *voice)
+{
+    // like the OPL3, only hard left, center or hard right
+    const int   pan = channels[voice->channel].pan;
+
+    voice->leftgain = (pan > 96 ? 0 : 256);
+    voice->rightgain = (pan < 32 ? 0 : 256);
+}
+
+static void SetOperator(opl_operator_t *op, const genmidi_op_t *data)
+{
+    static const int    multipliers[16] = { 1, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 20, 24, 24, 30, 30 };
+    const int           sustainlevel = data->sustain >> 4;
+
+    op->phase = 0;
+    op->multiplier = multipliers[data->tremolo & 0x0F];
+    op->sustaining = !!(data->tremolo & 0x20);
+    op->waveform = data->waveform & 0x03;
+    op->attackrate = attackrates[data->attack >> 4];
+    op->decayrate = decayrates[data->attack & 0x0F];
+    op->sustainlevel = (sustainlevel == 15 ? OPL_MAXATTENUATION : sustainlevel << 4) << 16;
+    op->releaserate = decayrates[data->sustain & 0x0F];
+    op->totallevel = (data->level & 0x3F) << 2;
+    op->env = OPL_MAXATTENUATION << 16;
+    op->state = (op->attackrate ? ENV_ATTACK : ENV_OFF);
+    op->out = 0;
+    op->prevout = 0;
+}
+
+static opl_voice_t *AllocateVoice(void)
+{
+    opl_voice_t *result = NULL;
+
+    // use a free voice, or else steal the oldest, preferring those already released
+    for (int i = 0; i < OPL_NUMVOICES; i++)
+    {
+        opl_voice_t *voice = &voices[i];
+
+        if (!voice->active)
+            return voice;
+
+        if (!result || (result->keyon && !voice->keyon)
+            || (result->keyon == voice->keyon && voice->age < result->age))
+            result = voice;
+    }
+
+    return result;
+}
+
+static void KeyOff(int channel, int key)
+{
+    for (int i = 0; i < OPL_NUMVOICES; i++)
+    {
+        opl_voice_t *voice = &voices[i];
+
+        if (voice->active && voice->keyon && voice->channel == channel && voice->key == key)
+        {
+            voice->keyon = false;
+
+            if (voice->modulator.state != ENV_OFF)
+                voice->modulator.state = ENV_RELEASE;
+
+            if (voice->carrier.state != ENV_OFF)
+                voice->carrier.state = ENV_RELEASE;
+        }
+    }
+}
+
+static void KeyOn(int channel, int key, int velocity)
+{
+    const genmidi_instr_t   *instr;
+    int                     numvoices;
+
+    if (channel == MUS_PERCUSSIONCHANNEL)
+    {
+        if (key < MUS_FIRSTPERCUSSION || key > MUS_LASTPERCUSSION)
+            return;
+
+        instr = &instrs[128 + key - MUS_FIRSTPERCUSSION];
+    }
+    else
+        instr = &instrs[channels[channel].instrument];
+
+    KeyOff(channel, key);
+
+    numvoices = ((SHORT(instr->flags) & GENMIDI_FLAG_2VOICE) ? 2 : 1);
+
+    for (int i = 0; i < numvoices; i++)
+    {
+        const genmidi_voice_t   *data = &instr->voices[i];
+        opl_voice_t             *voice = AllocateVoice();
+        int                     note;
+
+        if (SHORT(instr->flags) & GENMIDI_FLAG_FIXED)
+            note = instr->fixednote;
+        else
+            note = key + SHORT(data->basenoteoffset);
+
+        SetOperator(&voice->modulator, &data->modulator);
+        SetOperator(&voice->carrier, &data->carrier);
+        voice->feedback = (data->feedback >> 1) & 0x07;
+        voice->additive = !!(data->feedback & 0x01);
+        voice->channel = channel;
+        voice->key = key;
+        voice->note = BETWEEN(0, note, 127);
+        voice->finetune = (i ? instr->finetuning / 2 - 64 : 0);
+        voice->velocity = velocity;
+        voice->keyon = true;
+        voice->active = true;
+        voice->age = voiceage++;
+
+        SetVoiceFrequency(voice);
+        SetVoiceVolume(voice);
+        SetVoicePan(voice);
+    }
+}
+
+static void AllNotesOff(int channel, dboolean immediately)
+{
+    for (int i = 0; i < OPL_NUMVOICES; i++)
+    {
+        opl_voice_t *voice = &voices[i];
+
+        if (voice->active && voice->channel == channel)
+        {
+            if (immediately)
+                voice->active = false;
+            else
+                KeyOff(channel, voice->key);
+        }
+    }
+}
+
+static void ResetChannels(void)
+{
+    for (int i = 0; i < MUS_NUMCHANNELS; i++)
+    {
+        opl_channel_t   *channel = &channels[i];
+
+        channel->instrument = 0;
+        channel->volume = 100;
+        channel->pan = 64;
+        channel->bend = 0;
+        channel->notevolume = 127;
+    }
+
+    memset(voices, 0, sizeof(voices));
+}
+
+static void UpdateChannelVoices(int channel, void (*update)(opl_voice_t *))
+{
+    for (int i = 0; i < OPL_NUMVOICES; i++)
+        if (voices[i].active && voices[i].channel == channel)
+            update(&voices[i]);
+}
+
+static int ReadByte(void)
+{
+    return (scorepos < scorelength ? score[scorepos++] : -1);
+}
+
+// Process the MUS events up to the next delay. Returns false once the score has ended.
+static dboolean ProcessEvents(void)
+{
+    dboolean    restarted = false;
+
+    while (true)
+    {
+        int     event = ReadByte();
+        int     channel;
+        int     data;
+
+        if (event < 0 || ((event >> 4) & 0x07) == 6)
+        {
+            // end of score
+            if (!songlooping || restarted)
+                return false;
+
+            ResetChannels();
+            scorepos = 0;
+            restarted = true;
+            continue;
+        }
+
+        channel = event & 0x0F;
+
+        switch ((event >> 4) & 0x07)
+        {
+            case 0:     // release note
+                KeyOff(channel, ReadByte() & 0x7F);
+                break;
+
+            case 1:     // play note
+                data = ReadByte();
+
+                if (data & 0x80)
+                    channels[channel].notevolume = ReadByte() & 0x7F;
+
+                if (channels[channel].notevolume)
+                    KeyOn(channel, data & 0x7F, channels[channel].notevolume);
+                else
+                    KeyOff(channel, data & 0x7F);
+
+                break;
+
+            case 2:     // pitch bend
+                channels[channel].bend = (ReadByte() & 0xFF) / 2 - 64;
+                UpdateChannelVoices(channel, SetVoiceFrequency);
+                break;
+
+            case 3:     // system event
+                data = ReadByte();
+
+                if (data == 10)
+                    AllNotesOff(channel, true);
+                else if (data == 11)
+                    AllNotesOff(channel, false);
+                else if (data == 14)
+                {
+                    channels[channel].volume = 100;
+                    channels[channel].pan = 64;
+                    channels[channel].bend = 0;
+                }
+
+                break;
+
+            case 4:     // change controller
+                data = ReadByte();
+
+                switch (data)
+                {
+                    case 0:
+                        channels[channel].instrument = ReadByte() & 0x7F;
+                        break;
+
+                    case 3:
+                        channels[channel].volume = ReadByte() & 0x7F;
+                        UpdateChannelVoices(channel, SetVoiceVolume);
+                        break;
+
+                    case 4:
+                        channels[channel].pan = ReadByte() & 0x7F;
+                        UpdateChannelVoices(channel, SetVoicePan);
+                        break;
+
+                    default:
+                        ReadByte();
+                        break;
+                }
+
+                break;
+
+            case 5:     // end of measure
+                break;
+
+            default:
+                return false;
+        }
+
+        if (event & 0x80)
+        {
+            // a delay, in ticks, follows the last event in a group
+            int ticks = 0;
+
+            do
+            {
+                if ((data = ReadByte()) < 0)
+                    break;
+
+                ticks = (ticks << 7) | (data & 0x7F);
+            } while (data & 0x80);
+
+            if (ticks)
+            {
+                waitsamples += (int64_t)ticks * samplespertick;
+                return true;
+            }
+        }
+    }
+}
+
+static int RenderOperator(opl_operator_t *op, int phasemod)
+{
+    int attenuation;
+
+    switch (op->state)
+    {
+        case ENV_ATTACK:
+            op->env -= (int)(((int64_t)op->env * op->attackrate) >> 16);
+
+            if (op->env < (1 << 16))
+            {
+                op->env = 0;
+                op->state = ENV_DECAY;
+            }
+
+            break;
+
+        case ENV_DECAY:
+            if ((op->env += op->decayrate) >= op->sustainlevel)
+            {
+                op->env = op->sustainlevel;
+                op->state = (op->sustaining ? ENV_SUSTAIN : ENV_RELEASE);
+            }
+
+            break;
+
+        case ENV_RELEASE:
+            if ((op->env += op->releaserate) >= (OPL_MAXATTENUATION << 16))
+            {
+                op->env = OPL_MAXATTENUATION << 16;
+                op->state = ENV_OFF;
+            }
+
+            break;
+
+        case ENV_OFF:
+            return 0;
+    }
+
+    op->phase += op->phaseinc;
+
+    if ((attenuation = (op->env >> 16) + op->level) >= OPL_MAXATTENUATION)
+        return 0;
+
+    return ((waveforms[op->waveform][((op->phase >> (32 - OPL_SINEBITS)) + phasemod) & (OPL_SINESIZE - 1)]
+        * exptable[attenuation]) >> 12);
+}
+
+static void RenderVoices(int16_t *stream, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        int left = 0;
+        int right = 0;
+
+        for (int j = 0; j < OPL_NUMVOICES; j++)
+        {
+            opl_voice_t     *voice = &voices[j];
+            opl_operator_t  *modulator = &voice->modulator;
+            int             feedback;
+            int             out;
+
+            if (!voice->active)
+                continue;
+
+            feedback = (voice->feedback ? (modulator->out + modulator->prevout) >> (9 - voice->feedback) : 0);
+            modulator->prevout = modulator->out;
+            modulator->out = RenderOperator(modulator, feedback);
+
+            if (voice->additive)
+            {
+                out = modulator->out + RenderOperator(&voice->carrier, 0);
+
+                if (modulator->state == ENV_OFF && voice->carrier.state == ENV_OFF)
+                    voice->active = false;
+            }
+            else
+            {
+                out = RenderOperator(&voice->carrier, modulator->out);
+
+                if (voice->carrier.state == ENV_OFF)
+                    voice->active = false;
+            }
+
+            left += out * voice->leftgain;
+            right += out * voice->rightgain;
+        }
+
+        left = (left >> 8) * volume >> 7;
+        right = (right >> 8) * volume >> 7;
+        *stream++ = (int16_t)BETWEEN(SHRT_MIN, left, SHRT_MAX);
+        *stream++ = (int16_t)BETWEEN(SHRT_MIN, right, SHRT_MAX);
+    }
+}
+
+// Called by SDL_mixer on the audio thread to fill its buffer with music
+static void RenderMusic(void *udata, Uint8 *stream, int len)
+{
+    const uint64_t  start = SDL_GetPerformanceCounter();
+    int16_t         *out = (int16_t *)stream;
+    int             frames = len / 4;
+
+    memset(stream, 0, len);
+
+    if (!songplaying || songpaused)
+        return;
+
+    while (frames > 0)
+    {
+        int count;
+
+        while (waitsamples < (1 << 16))
+            if (!ProcessEvents())
+            {
+                songplaying = false;
+                return;
+            }
+
+        count = (int)MIN(frames, waitsamples >> 16);
+        RenderVoices(out, count);
+        waitsamples -= (int64_t)count << 16;
+        out += count * 2;
+        frames -= count;
+    }
+
+    rendertime += SDL_GetPerformanceCounter() - start;
+    renderedsamples += len / 4;
+}
+
+dboolean I_OPLRegisterSong(void *data, int size)
+{
+    const byte  *header = data;
+    int         freq;
+    int         numchannels;
+    uint16_t    format;
+    int         scorestart;
+
+    if (!Mix_QuerySpec(&freq, &format, &numchannels) || format != AUDIO_S16SYS || numchannels != 2)
+        return false;
+
+    if (!LoadInstruments())
+        return false;
+
+    // like DMX, skip over anything before the header
+    for (int i = 0; i < 32 && size > 8 && memcmp(header, "MUS\x1a", 4); i++)
+    {
+        header++;
+        size--;
+    }
+
+    if (size <= 8 || memcmp(header, "MUS\x1a", 4))
+        return false;
+
+    scorelength = header[4] | (header[5] << 8);
+    scorestart = header[6] | (header[7] << 8);
+
+    if (scorestart >= size)
+        return false;
+
+    score = header + scorestart;
+    scorelength = MIN(scorelength, size - scorestart);
+
+    if (freq != oplrate)
+    {
+        oplrate = freq;
+        InitTables();
+    }
+
+    samplespertick = (int)(((int64_t)oplrate << 16) / OPL_TICKRATE);
+    return true;
+}
+
+void I_OPLPlaySong(dboolean looping)
+{
+    ResetChannels();
+    scorepos = 0;
+    waitsamples = 0;
+    songlooping = looping;
+    songpaused = false;
+    songplaying = true;
+    rendertime = 0;
+    renderedsamples = 0;
+
+    Mix_HookMusic(RenderMusic, NULL);
+}
+
+void I_OPLStopSong(void)
+{
+    // once unhooked, the audio thread no longer touches the song
+    Mix_HookMusic(NULL, NULL);
+    songplaying = false;
+}
+
+void I_OPLPauseSong(dboolean pause)
+{
+    songpaused = pause;
+}
+
+void I_OPLSetVolume(int vol)
+{
+    volume = vol;
+}
+
+// Returns the time, in milliseconds, spent rendering each second of music
+double I_OPLRenderTime(void)
+{
+    if (!renderedsamples || !oplrate)
+        return 0.0;
+
+    return (rendertime * 1000.0 / SDL_GetPerformanceFrequency()) / ((double)renderedsamples / oplrate);
+}
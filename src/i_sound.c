@@ -52,16 +52,82 @@ typedef struct allocated_sound_s allocated_sound_t;
 struct allocated_sound_s
 {
     sfxinfo_t               *sfxinfo;
-    Mix_Chunk               chunk;
+    int16_t                 *samples;
+    unsigned int            length;
+    int                     samplerate;
     int                     use_count;
-    int                     pitch;
+    unsigned int            released;
     allocated_sound_t       *prev;
     allocated_sound_t       *next;
 };
 
+// A sound effect being mixed into one of the channels. Positions and steps
+// are in 32.32 fixed point, so that sounds can be resampled on the fly.
+typedef struct
+{
+    allocated_sound_t       *snd;
+    uint64_t                position;
+    uint64_t                step;
+    int                     leftvol;
+    int                     rightvol;
+    int                     id;
+    dboolean                playing;
+} voice_t;
+
+typedef enum
+{
+    SOUND_START,
+    SOUND_STOP,
+    SOUND_UPDATE
+} soundcmdtype_t;
+
+// A change to a voice, passed from the game to the audio thread
+typedef struct
+{
+    soundcmdtype_t          type;
+    int                     channel;
+    allocated_sound_t       *snd;
+    uint64_t                step;
+    int                     leftvol;
+    int                     rightvol;
+    int                     id;
+} soundcmd_t;
+
+#define SOUNDCMDS           1024
+
 static dboolean             sound_initialized;
 
+// Voices are only touched by the audio thread. The game queues commands for
+// it to apply at the start of each callback, so that it never has to wait.
+static voice_t              voices[s_channels_max];
+
+// Single-producer/single-consumer ring buffer of commands. Only the game
+// writes soundcmdhead, and only the audio thread writes soundcmdtail. One
+// slot is always left empty, so that a full buffer can be told from an
+// empty one.
+static soundcmd_t           soundcmds[SOUNDCMDS];
+static SDL_atomic_t         soundcmdhead;
+static SDL_atomic_t         soundcmdtail;
+
+// Running totals of the commands queued by the game and applied by the audio
+// thread, used to tell when a released sound can no longer be being mixed
+static unsigned int         soundcmdspushed;
+static SDL_atomic_t         soundcmdsdrained;
+
+// The game's view of each channel: the sound it locked, and the id of the
+// last sound started on it. The audio thread sets the id of each sound that
+// finishes.
 static allocated_sound_t    *channels_playing[s_channels_max];
+static int                  channels_started[s_channels_max];
+static SDL_atomic_t         channels_finished[s_channels_max];
+
+// Channels whose sound couldn't be stopped because the command queue was full.
+// Their sounds stay locked until the stop has been queued.
+static dboolean             channels_stopping[s_channels_max];
+static int                  numchannelsstopping;
+
+// Stereo mix of one block of the output stream, before it's clipped
+static int32_t              mixbuffer[CHUNKSIZE * 2];
 
 static int                  mixer_freq = MIX_DEFAULT_FREQUENCY;
 
@@ -70,6 +136,13 @@ static int                  mixer_freq = MIX_DEFAULT_FREQUENCY;
 static allocated_sound_t    *allocated_sounds_head;
 static allocated_sound_t    *allocated_sounds_tail;
 
+// The allocated sound for each sound effect, if it's still cached
+static allocated_sound_t    *sfx_sounds[NUMSFX];
+
+size_t                      sfxcachebytes;
+int                         sfxcachehits;
+int                         sfxcachemisses;
+
 // Hook a sound into the linked list at the head.
 static void AllocatedSoundLink(allocated_sound_t *snd)
 {
@@ -102,18 +175,28 @@ static void FreeAllocatedSound(allocated_sound_t *snd)
 {
     // Unlink from linked list.
     AllocatedSoundUnlink(snd);
+    sfx_sounds[snd->sfxinfo - S_sfx] = NULL;
+    sfxcachebytes -= snd->length * sizeof(int16_t);
     free(snd);
 }
 
+// A sound can be freed once it isn't locked, and the audio thread has applied the command that
+// stopped it the last time it was released.
+static dboolean CanFreeSound(allocated_sound_t *snd)
+{
+    return (!snd->use_count && (int)((unsigned int)SDL_AtomicGet(&soundcmdsdrained) - snd->released) >= 0);
+}
+
 // Search from the tail backwards along the allocated sounds list, find and free a sound that is
-// not in use, to free up memory. Return true for success.
+// not in use, to free up memory. The sound at the head isn't freed, since it has only just been
+// allocated or played. Return true for success.
 static dboolean FindAndFreeSound(void)
 {
     allocated_sound_t   *snd = allocated_sounds_tail;
 
-    while (snd)
+    while (snd && snd != allocated_sounds_head)
     {
-        if (!snd->use_count)
+        if (CanFreeSound(snd))
         {
             FreeAllocatedSound(snd);
             return true;
@@ -126,6 +209,16 @@ static dboolean FindAndFreeSound(void)
     return false;
 }
 
+// Free the least recently played sounds that aren't in use until all of them fit within the
+// s_cachesize CVAR.
+static void TrimSoundCache(void)
+{
+    const size_t    budget = (size_t)s_cachesize * 1024 * 1024;
+
+    if (s_cachesize)
+        while (sfxcachebytes > budget && FindAndFreeSound());
+}
+
 // Allocate a block for a new sound effect.
 static allocated_sound_t *AllocateSound(sfxinfo_t *sfxinfo, int len)
 {
@@ -140,16 +233,14 @@ static allocated_sound_t *AllocateSound(sfxinfo_t *sfxinfo, int len)
             return NULL;
     } while (!snd);
 
-    // Skip past the chunk structure for the audio buffer
-    snd->chunk.abuf = (uint8_t *)(snd + 1);
-    snd->chunk.alen = len;
-    snd->chunk.allocated = 1;
-    snd->chunk.volume = MIX_MAX_VOLUME;
-    snd->pitch = NORM_PITCH;
+    // Skip past the header for the samples
+    snd->samples = (int16_t *)(snd + 1);
     snd->sfxinfo = sfxinfo;
     snd->use_count = 0;
 
     AllocatedSoundLink(snd);
+    sfx_sounds[sfxinfo - S_sfx] = snd;
+    sfxcachebytes += len;
 
     return snd;
 }
@@ -172,116 +263,232 @@ static void UnlockAllocatedSound(allocated_sound_t *snd)
     snd->use_count--;
 }
 
-static allocated_sound_t *GetAllocatedSoundBySfxInfoAndPitch(sfxinfo_t *sfxinfo, int pitch)
+static dboolean CacheSFX(sfxinfo_t *sfxinfo);
+
+static allocated_sound_t *GetAllocatedSoundBySfxInfo(sfxinfo_t *sfxinfo)
 {
-    allocated_sound_t   *p = allocated_sounds_head;
+    allocated_sound_t   *snd = sfx_sounds[sfxinfo - S_sfx];
 
-    while (p)
+    if (snd)
+        sfxcachehits++;
+    else
     {
-        if (p->sfxinfo == sfxinfo && p->pitch == pitch)
-            return p;
+        // it's being played for the first time, or was freed to keep the cache within its budget
+        sfxcachemisses++;
 
-        p = p->next;
+        if (CacheSFX(sfxinfo))
+            snd = sfx_sounds[sfxinfo - S_sfx];
     }
 
-    return NULL;
+    return snd;
 }
 
-// Allocate a new sound chunk and pitch-shift an existing sound up-or-down into it.
-static allocated_sound_t *PitchShift(allocated_sound_t *insnd, int pitch)
+// Mix count frames of a voice into the mix buffer, resampling it to mixer_freq with linear
+// interpolation as it goes.
+static void MixVoice(voice_t *voice, int32_t *buffer, int count)
 {
-    allocated_sound_t   *outsnd;
-    int16_t             *srcbuf;
-    int16_t             *dstbuf;
-    const uint32_t      srclen = insnd->chunk.alen;
+    const int16_t   *samples = voice->snd->samples;
+    const uint64_t  end = (uint64_t)(voice->snd->length - 1) << 32;
+    const uint64_t  step = voice->step;
+    const int       leftvol = voice->leftvol;
+    const int       rightvol = voice->rightvol;
+    uint64_t        position = voice->position;
+    dboolean        finished = true;
+
+    // stop at the last sample, since each frame is interpolated with the next one
+    if (position >= end)
+        count = 0;
+    else if ((end - position + step - 1) / step <= (uint64_t)count)
+        count = (int)((end - position + step - 1) / step);
+    else
+        finished = false;
 
-    // determine ratio pitch:NORM_PITCH and apply to srclen, then invert.
-    // This is an approximation of vanilla behavior based on measurements
-    uint32_t            dstlen = (uint32_t)((1 + (1 - (float)pitch / NORM_PITCH)) * srclen);
+    if (finished)
+    {
+        voice->playing = false;
+        SDL_AtomicSet(&channels_finished[voice - voices], voice->id);
+    }
+
+    // no branches in here, so that it can be vectorized. The fraction is only 15 bits, so that
+    // multiplying it by the difference between two samples can't overflow.
+    for (int i = 0; i < count; i++)
+    {
+        const unsigned int  index = (unsigned int)(position >> 32);
+        const int           frac = (int)((position >> 17) & 0x7FFF);
+        const int           sample = samples[index] + (((samples[index + 1] - samples[index]) * frac) >> 15);
+
+        buffer[i * 2] += (sample * leftvol) >> 8;
+        buffer[i * 2 + 1] += (sample * rightvol) >> 8;
+        position += step;
+    }
+
+    voice->position = position;
+}
 
-    // ensure that the new buffer is an even length
-    if (!(dstlen % 2))
-        dstlen++;
+// Queue a command for the audio thread. Returns false if the queue is full.
+static dboolean PushSoundCommand(const soundcmd_t *cmd)
+{
+    const int   head = SDL_AtomicGet(&soundcmdhead);
+    const int   next = (head + 1) & (SOUNDCMDS - 1);
 
-    if (!(outsnd = AllocateSound(insnd->sfxinfo, dstlen)))
-        return NULL;
+    if (next == SDL_AtomicGet(&soundcmdtail))
+        return false;
 
-    outsnd->pitch = pitch;
-    srcbuf = (int16_t *)insnd->chunk.abuf;
-    dstbuf = (int16_t *)outsnd->chunk.abuf;
+    // SDL_AtomicSet() is only an acquire barrier, so make sure the audio thread has finished
+    // reading the slot before it's overwritten, and that the command is written before it's seen
+    SDL_MemoryBarrierAcquire();
+    soundcmds[head] = *cmd;
+    SDL_MemoryBarrierRelease();
+    SDL_AtomicSet(&soundcmdhead, next);
+    soundcmdspushed++;
 
-    // loop over output buffer. find corresponding input cell, copy over
-    for (int16_t *inp, *outp = dstbuf; outp < dstbuf + dstlen / 2; outp++)
+    return true;
+}
+
+// Apply every command the game has queued since the last callback.
+static void DrainSoundCommands(void)
+{
+    const int   head = SDL_AtomicGet(&soundcmdhead);
+    int         tail = SDL_AtomicGet(&soundcmdtail);
+    int         drained = 0;
+
+    // make sure the commands up to head are read only after head is
+    SDL_MemoryBarrierAcquire();
+
+    for (; tail != head; tail = (tail + 1) & (SOUNDCMDS - 1), drained++)
     {
-        inp = &srcbuf[(int)((float)(outp - dstbuf) / dstlen * srclen)];
-        *outp = *inp;
+        const soundcmd_t    *cmd = &soundcmds[tail];
+        voice_t             *voice = &voices[cmd->channel];
+
+        switch (cmd->type)
+        {
+            case SOUND_START:
+                voice->snd = cmd->snd;
+                voice->position = 0;
+                voice->step = cmd->step;
+                voice->id = cmd->id;
+                voice->playing = true;
+
+                // fall through
+
+            case SOUND_UPDATE:
+                voice->leftvol = cmd->leftvol;
+                voice->rightvol = cmd->rightvol;
+                break;
+
+            case SOUND_STOP:
+                voice->playing = false;
+                break;
+        }
     }
 
-    return outsnd;
+    // make sure the commands have been read before the game can overwrite them
+    SDL_MemoryBarrierRelease();
+    SDL_AtomicSet(&soundcmdtail, tail);
+    SDL_AtomicAdd(&soundcmdsdrained, drained);
+}
+
+// Called by SDL_mixer in the audio thread once it has mixed the music, to mix the sound effects
+// into the output stream.
+static void MixVoices(void *udata, Uint8 *stream, int len)
+{
+    int16_t *output = (int16_t *)stream;
+    int     frames = len / (2 * sizeof(int16_t));
+
+    DrainSoundCommands();
+
+    while (frames > 0)
+    {
+        const int   count = MIN(frames, CHUNKSIZE);
+
+        for (int i = 0; i < count * 2; i++)
+            mixbuffer[i] = output[i];
+
+        for (int i = 0; i < s_channels_max; i++)
+            if (voices[i].playing)
+                MixVoice(&voices[i], mixbuffer, count);
+
+        for (int i = 0; i < count * 2; i++)
+            output[i] = (int16_t)BETWEEN(INT16_MIN, mixbuffer[i], INT16_MAX);
+
+        output += count * 2;
+        frames -= count;
+    }
 }
 
-// When a sound stops, check if it is still playing. If it is not, we can mark the sound data as
-// CACHE to be freed back for other means.
-static void ReleaseSoundOnChannel(int channel)
+// When a sound stops, stop mixing it and unlock its data so that it can be freed once the audio
+// thread has stopped mixing it. If the command queue is full, the sound stays locked and playing,
+// and false is returned.
+static dboolean ReleaseSoundOnChannel(int channel)
 {
     allocated_sound_t   *snd = channels_playing[channel];
+    soundcmd_t          cmd = { SOUND_STOP, channel };
 
     if (!snd)
-        return;
+        return true;
+
+    if (!PushSoundCommand(&cmd))
+    {
+        if (!channels_stopping[channel])
+        {
+            channels_stopping[channel] = true;
+            numchannelsstopping++;
+        }
+
+        return false;
+    }
 
-    Mix_HaltChannel(channel);
+    if (channels_stopping[channel])
+    {
+        channels_stopping[channel] = false;
+        numchannelsstopping--;
+    }
 
+    snd->released = soundcmdspushed;
     channels_playing[channel] = NULL;
     UnlockAllocatedSound(snd);
 
-    // if the sound is a pitch-shift and it's not in use, immediately free it
-    if (snd->pitch != NORM_PITCH && snd->use_count <= 0)
-        FreeAllocatedSound(snd);
+    return true;
 }
 
-// Generic sound expansion function for any sample rate.
-static void ExpandSoundData(sfxinfo_t *sfxinfo, byte *data, int samplerate, int bits, int length)
+// Try again to stop the sounds that couldn't be stopped earlier.
+static void ReleaseStoppingSounds(void)
+{
+    for (int i = 0; i < s_channels_max && numchannelsstopping; i++)
+        if (channels_stopping[i] && !ReleaseSoundOnChannel(i))
+            return;
+}
+
+// Convert a sound effect to signed 16-bit samples at its original sample rate. It's resampled as
+// it's mixed.
+static dboolean ConvertSoundData(sfxinfo_t *sfxinfo, byte *data, int samplerate, int bits, int length)
 {
     unsigned int        samplecount = length / (bits / 8);
-    unsigned int        expanded_length = (unsigned int)(((uint64_t)samplecount * mixer_freq) / samplerate);
-    allocated_sound_t   *snd = AllocateSound(sfxinfo, expanded_length * 4);
-    int16_t             *expanded = (int16_t *)(&snd->chunk)->abuf;
-    int                 expand_ratio = (samplecount << 8) / expanded_length;
-    double              dt = 1.0 / mixer_freq;
-    double              alpha = dt / (1.0 / (M_PI * samplerate) + dt);
+    allocated_sound_t   *snd;
+    int16_t             *samples;
 
-    if (bits == 8)
-        for (unsigned int i = 0; i < expanded_length; i++)
-        {
-            int src = data[(i * expand_ratio) >> 8];
+    if (!(snd = AllocateSound(sfxinfo, samplecount * sizeof(int16_t))))
+        return false;
 
-            expanded[i * 2] = expanded[i * 2 + 1] = (src | (src << 8)) - 32768;
-        }
-    else
-        for (unsigned int i = 0; i < expanded_length; i++)
-        {
-            int src = ((i * expand_ratio) >> 8) * 2;
+    TrimSoundCache();
 
-            expanded[i * 2] = expanded[i * 2 + 1] = (data[src] | (data[src + 1] << 8));
-        }
+    snd->length = samplecount;
+    snd->samplerate = samplerate;
+    samples = snd->samples;
+
+    if (bits == 8)
+        for (unsigned int i = 0; i < samplecount; i++)
+            samples[i] = (data[i] | (data[i] << 8)) - 32768;
+    else
+        for (unsigned int i = 0; i < samplecount; i++)
+            samples[i] = (data[i * 2] | (data[i * 2 + 1] << 8));
 
-    // Apply low-pass filter
-    for (unsigned int i = 2; i < expanded_length * 2; i++)
-        expanded[i] = (int16_t)(alpha * expanded[i] + (1.0 - alpha) * expanded[i - 2]);
+    return true;
 }
 
-// Load and convert a sound effect
-// Returns true if successful
-dboolean CacheSFX(sfxinfo_t *sfxinfo)
+// Find the samples in a sound lump. Returns true if it's in a format that can be played.
+static dboolean ParseSFX(const byte *data, int lumplen, int *samplerate, int *bits, int *offset, int *length)
 {
-    // need to load the sound
-    int     lumpnum = sfxinfo->lumpnum;
-    byte    *data = W_CacheLumpNum(lumpnum);
-    int     lumplen = W_LumpLength(lumpnum);
-    int     samplerate;
-    int     bits = 8;
-    int     length;
-
     // Check the header, and ensure this is a valid sound
     if (lumplen > 44 && !memcmp(data, "RIFF", 4) && !memcmp(data + 8, "WAVEfmt ", 8))
     {
@@ -298,19 +505,18 @@ dboolean CacheSFX(sfxinfo_t *sfxinfo)
             return false;
 
         // Must be 8 or 16-bit
-        if ((bits = (data[34] | (data[35] << 8))) != 8 && bits != 16)
+        if ((*bits = (data[34] | (data[35] << 8))) != 8 && *bits != 16)
             return false;
 
-        samplerate = (data[24] | (data[25] << 8) | (data[26] << 16) | (data[27] << 24));
-        length = MIN((data[40] | (data[41] << 8) | (data[42] << 16) | (data[43] << 24)), lumplen - 44);
-
-        ExpandSoundData(sfxinfo, data + 44, samplerate, bits, length);
-        return true;
+        *samplerate = (data[24] | (data[25] << 8) | (data[26] << 16) | (data[27] << 24));
+        *offset = 44;
+        *length = MIN((data[40] | (data[41] << 8) | (data[42] << 16) | (data[43] << 24)), lumplen - 44);
     }
     else if (lumplen >= 8 && data[0] == 0x03 && data[1] == 0x00)
     {
-        samplerate = (data[2] | (data[3] << 8));
-        length = (data[4] | (data[5] << 8) | (data[6] << 16) | (data[7] << 24));
+        *samplerate = (data[2] | (data[3] << 8));
+        *bits = 8;
+        *length = (data[4] | (data[5] << 8) | (data[6] << 16) | (data[7] << 24));
 
         // If the header specifies that the length of the sound is greater than the length of the lump
         // itself, this is an invalid sound lump
@@ -318,80 +524,138 @@ dboolean CacheSFX(sfxinfo_t *sfxinfo)
         // We also discard sound lumps that are less than 49 samples long, as this is how DMX behaves -
         // although the actual cut-off length seems to vary slightly depending on the sample rate. This
         // needs further investigation to better understand the correct behavior.
-        if (length > lumplen - 8 || length <= 48)
+        if (*length > lumplen - 8 || *length <= 48)
             return false;
 
-        ExpandSoundData(sfxinfo, data + 24, samplerate, bits, length - 32);
-        return true;
+        *offset = 24;
+        *length -= 32;
     }
     else
         return false;
+
+    // there must be at least two samples to interpolate between
+    return (*samplerate > 0 && *length >= 2 * (*bits / 8));
+}
+
+// Check that a sound effect can be played. It isn't converted until the first time it's played.
+// Returns true if successful
+dboolean CheckSFX(sfxinfo_t *sfxinfo)
+{
+    const int       lumpnum = sfxinfo->lumpnum;
+    int             samplerate;
+    int             bits;
+    int             offset;
+    int             length;
+    const dboolean  result = ParseSFX(W_CacheLumpNum(lumpnum), W_LumpLength(lumpnum), &samplerate, &bits, &offset, &length);
+
+    W_ReleaseLumpNum(lumpnum);
+
+    return result;
+}
+
+// Load and convert a sound effect
+// Returns true if successful
+static dboolean CacheSFX(sfxinfo_t *sfxinfo)
+{
+    const int   lumpnum = sfxinfo->lumpnum;
+    byte        *data = W_CacheLumpNum(lumpnum);
+    int         samplerate;
+    int         bits;
+    int         offset;
+    int         length;
+    dboolean    result = false;
+
+    if (ParseSFX(data, W_LumpLength(lumpnum), &samplerate, &bits, &offset, &length))
+        result = ConvertSoundData(sfxinfo, data + offset, samplerate, bits, length);
+
+    // the sound has been converted, so the lump is no longer needed
+    W_ReleaseLumpNum(lumpnum);
+
+    return result;
 }
 
-void I_UpdateSoundParms(int channel, int vol, int sep)
+// Returns false if the command queue is full, so that the update can be tried again later.
+dboolean I_UpdateSoundParms(int channel, int vol, int sep)
 {
-    Mix_SetPanning(channel, (254 - sep) * vol / MIX_MAX_VOLUME, sep * vol / MIX_MAX_VOLUME);
+    soundcmd_t  cmd = { SOUND_UPDATE, channel };
+
+    cmd.leftvol = (254 - sep) * vol / MIX_MAX_VOLUME;
+    cmd.rightvol = sep * vol / MIX_MAX_VOLUME;
+
+    return PushSoundCommand(&cmd);
 }
 
 //
 // Starting a sound means adding it to the current list of active sounds in the internal channels.
 // As the SFX info struct contains e.g. a pointer to the raw data, it is ignored.
 // As our sound handling does not handle priority, it is ignored.
-// Pitching (that is, increased speed of playback) is set, but currently not used by mixing.
+// Pitching (that is, increased speed of playback) is applied by the rate at which the sound is
+// resampled as it's mixed.
 //
 int I_StartSound(sfxinfo_t *sfxinfo, int channel, int vol, int sep, int pitch)
 {
     allocated_sound_t   *snd;
+    soundcmd_t          cmd = { SOUND_START, channel };
+    double              step;
+
+    if (numchannelsstopping)
+        ReleaseStoppingSounds();
 
     // Release a sound effect if there is already one playing on this channel
-    ReleaseSoundOnChannel(channel);
+    if (!ReleaseSoundOnChannel(channel))
+        return -1;
 
-    if (!(snd = GetAllocatedSoundBySfxInfoAndPitch(sfxinfo, pitch)))
-    {
-        // fetch the base sound effect, un-pitch-shifted
-        if (!(snd = GetAllocatedSoundBySfxInfoAndPitch(sfxinfo, NORM_PITCH)))
-            return -1;
+    if (!(snd = GetAllocatedSoundBySfxInfo(sfxinfo)))
+        return -1;
 
-        if (s_randompitch && pitch && pitch != NORM_PITCH)
-        {
-            allocated_sound_t   *newsnd = PitchShift(snd, pitch);
-
-            if (newsnd)
-            {
-                LockAllocatedSound(newsnd);
-                UnlockAllocatedSound(snd);
-                snd = newsnd;
-            }
-        }
-    }
-    else
-        LockAllocatedSound(snd);
+    LockAllocatedSound(snd);
+
+    // determine ratio pitch:NORM_PITCH and apply to the sound's length.
+    // This is an approximation of vanilla behavior based on measurements
+    step = (double)snd->samplerate / mixer_freq;
+
+    if (s_randompitch && pitch && pitch != NORM_PITCH)
+        step /= 2.0 - (double)pitch / NORM_PITCH;
 
     // play sound
-    Mix_PlayChannel(channel, &snd->chunk, 0);
+    cmd.snd = snd;
+    cmd.step = (uint64_t)(step * 4294967296.0);
+    cmd.leftvol = (254 - sep) * vol / MIX_MAX_VOLUME;
+    cmd.rightvol = sep * vol / MIX_MAX_VOLUME;
+    cmd.id = ++channels_started[channel];
 
-    channels_playing[channel] = snd;
+    if (!PushSoundCommand(&cmd))
+    {
+        UnlockAllocatedSound(snd);
+        return -1;
+    }
 
-    // set separation, etc.
-    I_UpdateSoundParms(channel, vol, sep);
+    channels_playing[channel] = snd;
 
     return channel;
 }
 
 void I_StopSound(int channel)
 {
+    if (numchannelsstopping)
+        ReleaseStoppingSounds();
+
     // Sound data is no longer needed; release the sound data being used for this channel
     ReleaseSoundOnChannel(channel);
 }
 
 dboolean I_SoundIsPlaying(int channel)
 {
-    return Mix_Playing(channel);
+    return (channels_playing[channel] && SDL_AtomicGet(&channels_finished[channel]) != channels_started[channel]);
 }
 
 dboolean I_AnySoundStillPlaying(void)
 {
-    return Mix_Playing(-1);
+    for (int i = 0; i < s_channels_max; i++)
+        if (I_SoundIsPlaying(i))
+            return true;
+
+    return false;
 }
 
 void I_ShutdownSound(void)
@@ -399,6 +663,7 @@ void I_ShutdownSound(void)
     if (!sound_initialized)
         return;
 
+    Mix_SetPostMix(NULL, NULL);
     Mix_CloseAudio();
     SDL_QuitSubSystem(SDL_INIT_AUDIO);
     sound_initialized = false;
@@ -411,8 +676,19 @@ dboolean I_InitSound(void)
     int                 mixer_channels;
 
     // No sounds yet
+    memset(voices, 0, sizeof(voices));
+    SDL_AtomicSet(&soundcmdhead, 0);
+    SDL_AtomicSet(&soundcmdtail, 0);
+
     for (int i = 0; i < s_channels_max; i++)
+    {
         channels_playing[i] = NULL;
+        channels_stopping[i] = false;
+        channels_started[i] = 0;
+        SDL_AtomicSet(&channels_finished[i], 0);
+    }
+
+    numchannelsstopping = 0;
 
     if (SDL_InitSubSystem(SDL_INIT_AUDIO) < 0)
         return false;
@@ -432,7 +708,14 @@ dboolean I_InitSound(void)
     if (!Mix_QuerySpec(&mixer_freq, &mixer_format, &mixer_channels))
         return false;
 
-    Mix_AllocateChannels(s_channels_max);
+    // sound effects are mixed into SDL_mixer's output, so it must be 16-bit stereo
+    if (mixer_format != AUDIO_S16SYS || mixer_channels != 2)
+    {
+        Mix_CloseAudio();
+        return false;
+    }
+
+    Mix_SetPostMix(MixVoices, NULL);
     SDL_PauseAudio(0);
     sound_initialized = true;
 
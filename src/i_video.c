@@ -954,6 +954,15 @@ static void I_Blit_NearestLinear_ShowFPS_Shake(void)
     SDL_RenderPresent(renderer);
 }
 
+// -headless: still convert the frame, but don't upload or present it
+static void I_Blit_Headless(void)
+{
+    if (vid_showfps)
+        CalculateFPS();
+
+    SDL_LowerBlit(surface, &src_rect, buffer, &src_rect);
+}
+
 static void I_Blit_Automap(void)
 {
     SDL_LowerBlit(mapsurface, &map_rect, mapbuffer, &map_rect);
@@ -979,6 +988,13 @@ void I_UpdateBlitFunc(dboolean shake)
 {
     dboolean    nearest = (nearestlinear && (displayheight % VANILLAHEIGHT));
 
+    if (headless)
+    {
+        blitfunc = &I_Blit_Headless;
+        mapblitfunc = &nullfunc;
+        return;
+    }
+
     if (shake && !software)
         blitfunc = (nearest ? (vid_showfps ? &I_Blit_NearestLinear_ShowFPS_Shake : &I_Blit_NearestLinear_Shake) :
             (vid_showfps ? &I_Blit_ShowFPS_Shake : &I_Blit_Shake));
@@ -1449,10 +1465,11 @@ static void SetVideoMode(dboolean createwindow, dboolean output)
             I_SDLError(SDL_SetHintWithPriority);
     }
 
-    if (!(SDL_SetHintWithPriority(SDL_HINT_RENDER_DRIVER, vid_scaleapi, SDL_HINT_OVERRIDE)))
+    // the dummy video driver only has a software renderer, so use it without changing vid_scaleapi
+    if (!(SDL_SetHintWithPriority(SDL_HINT_RENDER_DRIVER, (headless ? vid_scaleapi_software : vid_scaleapi), SDL_HINT_OVERRIDE)))
         I_SDLError(SDL_SetHintWithPriority);
 
-    software = M_StringCompare(vid_scaleapi, vid_scaleapi_software);
+    software = (headless || M_StringCompare(vid_scaleapi, vid_scaleapi_software));
 
     GetWindowPosition();
     GetWindowSize();
@@ -2034,8 +2051,11 @@ void I_InitGraphics(void)
     I_InitGammaTables();
     I_SetGamma(r_gamma);
 
+    // -headless: use SDL's dummy video driver, which never opens a window
+    if (headless)
+        SDL_setenv("SDL_VIDEODRIVER", "dummy", true);
 #if !defined(_WIN32)
-    if (*vid_driver)
+    else if (*vid_driver)
         SDL_setenv("SDL_VIDEODRIVER", vid_driver, true);
 #endif
 
@@ -52,7 +52,7 @@
 
 static dboolean cvarsloaded;
 
-#define NUMCVARS                                                204
+#define NUMCVARS                                                208
 
 #define CONFIG_VARIABLE_INT(name1, name2, cvar, set)            { #name1, #name2, &cvar, DEFAULT_INT32,         set          }
 #define CONFIG_VARIABLE_INT_UNSIGNED(name1, name2, cvar, set)   { #name1, #name2, &cvar, DEFAULT_UINT64,        set          }
@@ -94,6 +94,7 @@ static default_t cvars[NUMCVARS] =
     CONFIG_VARIABLE_INT          (autosave,                         autosave,                              autosave,                              BOOLVALUEALIAS        ),
     CONFIG_VARIABLE_INT          (autotilt,                         autotilt,                              autotilt,                              BOOLVALUEALIAS        ),
     CONFIG_VARIABLE_INT          (autouse,                          autouse,                               autouse,                               BOOLVALUEALIAS        ),
+    CONFIG_VARIABLE_INT          (cachesize,                        cachesize,                             cachesize,                             NOVALUEALIAS          ),
     CONFIG_VARIABLE_INT          (centerweapon,                     centreweapon,                          centerweapon,                          BOOLVALUEALIAS        ),
     CONFIG_VARIABLE_INT          (con_backcolor,                    con_backcolour,                        con_backcolor,                         NOVALUEALIAS          ),
     CONFIG_VARIABLE_INT          (con_edgecolor,                    con_edgecolour,                        con_edgecolor,                         NOVALUEALIAS          ),
@@ -174,8 +175,11 @@ static default_t cvars[NUMCVARS] =
     CONFIG_VARIABLE_INT          (r_supersampling,                  r_supersampling,                       r_supersampling,                       BOOLVALUEALIAS        ),
     CONFIG_VARIABLE_INT          (r_textures,                       r_textures,                            r_textures,                            BOOLVALUEALIAS        ),
     CONFIG_VARIABLE_INT          (r_translucency,                   r_translucency,                        r_translucency,                        BOOLVALUEALIAS        ),
+    CONFIG_VARIABLE_INT          (s_cachesize,                      s_cachesize,                           s_cachesize,                           NOVALUEALIAS          ),
     CONFIG_VARIABLE_INT          (s_channels,                       s_channels,                            s_channels,                            NOVALUEALIAS          ),
     CONFIG_VARIABLE_INT_PERCENT  (s_musicvolume,                    s_musicvolume,                         s_musicvolume,                         NOVALUEALIAS          ),
+    CONFIG_VARIABLE_INT          (s_occlusion,                      s_occlusion,                           s_occlusion,                           BOOLVALUEALIAS        ),
+    CONFIG_VARIABLE_INT          (s_oplmusic,                       s_oplmusic,                            s_oplmusic,                            BOOLVALUEALIAS        ),
     CONFIG_VARIABLE_INT          (s_randommusic,                    s_randommusic,                         s_randommusic,                         BOOLVALUEALIAS        ),
     CONFIG_VARIABLE_INT          (s_randompitch,                    s_randompitch,                         s_randompitch,                         BOOLVALUEALIAS        ),
     CONFIG_VARIABLE_INT_PERCENT  (s_sfxvolume,                      s_sfxvolume,                           s_sfxvolume,                           NOVALUEALIAS          ),
@@ -640,6 +644,8 @@ static void M_CheckCVARs(dboolean ispackageconfig)
     if (autouse != false && autouse != true)
         autouse = autouse_default;
 
+    cachesize = BETWEEN(cachesize_min, cachesize, cachesize_max);
+
     if (centerweapon != false && centerweapon != true)
         centerweapon = centerweapon_default;
 
@@ -888,11 +894,19 @@ static void M_CheckCVARs(dboolean ispackageconfig)
     if (r_translucency != false && r_translucency != true)
         r_translucency = r_translucency_default;
 
+    s_cachesize = BETWEEN(s_cachesize_min, s_cachesize, s_cachesize_max);
+
     s_channels = BETWEEN(s_channels_min, s_channels, s_channels_max);
 
     s_musicvolume = BETWEEN(s_musicvolume_min, s_musicvolume, s_musicvolume_max);
     musicVolume = (s_musicvolume * 31 + 50) / 100;
 
+    if (s_occlusion != false && s_occlusion != true)
+        s_occlusion = s_occlusion_default;
+
+    if (s_oplmusic != false && s_oplmusic != true)
+        s_oplmusic = s_oplmusic_default;
+
     if (s_randommusic != false && s_randommusic != true)
         s_randommusic = s_randommusic_default;
 
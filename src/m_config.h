@@ -70,6 +70,7 @@ extern dboolean     autoload;
 extern dboolean     autosave;
 extern dboolean     autotilt;
 extern dboolean     autouse;
+extern int          cachesize;
 extern dboolean     centerweapon;
 extern int          con_backcolor;
 extern int          con_edgecolor;
@@ -151,8 +152,11 @@ extern int          r_skycolor;
 extern dboolean     r_supersampling;
 extern dboolean     r_textures;
 extern dboolean     r_translucency;
+extern int          s_cachesize;
 extern int          s_channels;
 extern int          s_musicvolume;
+extern dboolean     s_occlusion;
+extern dboolean     s_oplmusic;
 extern dboolean     s_randommusic;
 extern dboolean     s_randompitch;
 extern int          s_sfxvolume;
@@ -389,6 +393,10 @@ enum
 
 #define autouse_default                         false
 
+#define cachesize_min                           0
+#define cachesize_default                       0
+#define cachesize_max                           4096
+
 #define centerweapon_default                    true
 
 #define con_backcolor_min                       0
@@ -616,6 +624,10 @@ enum
 
 #define r_translucency_default                  true
 
+#define s_cachesize_min                         0
+#define s_cachesize_default                     0
+#define s_cachesize_max                         1024
+
 #define s_channels_min                          8
 #define s_channels_default                      32
 #define s_channels_max                          64
@@ -624,6 +636,10 @@ enum
 #define s_musicvolume_default                   100
 #define s_musicvolume_max                       100
 
+#define s_occlusion_default                     false
+
+#define s_oplmusic_default                      false
+
 #define s_randommusic_default                   false
 
 #define s_randompitch_default                   false
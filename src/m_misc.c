@@ -377,6 +377,110 @@ char *M_TempFile(char *s)
     return M_StringJoin(tempdir, DIR_SEPARATOR_S, s, NULL);
 }
 
+// The startup cache stores data that is expensive to generate from the
+// loaded WADs in files in the "cache" folder. Each file has a header
+// holding the version of DOOM Retro and a key that is a hash of the data
+// the contents were generated from, so it will never be used if either
+// has changed.
+#define CACHEID "DRCACHE"
+
+typedef struct
+{
+    char        id[8];
+    char        version[16];
+    uint64_t    key;
+    uint64_t    length;
+} cacheheader_t;
+
+int cachehits;
+int cachemisses;
+
+// 64-bit FNV-1a hash. Pass 0 as the hash to start a new hash.
+uint64_t M_HashData(const void *data, size_t length, uint64_t hash)
+{
+    const byte  *p = data;
+
+    if (!hash)
+        hash = 0xCBF29CE484222325ull;
+
+    while (length--)
+        hash = (hash ^ *p++) * 0x100000001B3ull;
+
+    return hash;
+}
+
+static char *M_CacheFilename(const char *name)
+{
+    char    *appdatafolder = M_GetAppDataFolder();
+    char    *cachefolder = M_StringJoin(appdatafolder, DIR_SEPARATOR_S "cache", NULL);
+    char    *filename = M_StringJoin(cachefolder, DIR_SEPARATOR_S, name, ".cache", NULL);
+
+    M_MakeDirectory(cachefolder);
+    free(cachefolder);
+
+    return filename;
+}
+
+static void M_CacheHeader(cacheheader_t *header, uint64_t key, size_t length)
+{
+    memset(header, 0, sizeof(*header));
+    memcpy(header->id, CACHEID, sizeof(header->id));
+    M_StringCopy(header->version, PACKAGE_VERSIONSTRING, sizeof(header->version));
+    header->key = key;
+    header->length = length;
+}
+
+// Read length bytes of data from the named cache file into data. Returns
+// false if the file doesn't exist or was generated from different data.
+dboolean M_ReadCacheFile(const char *name, uint64_t key, void *data, size_t length)
+{
+    char            *filename = M_CacheFilename(name);
+    FILE            *file = fopen(filename, "rb");
+    cacheheader_t   header;
+    cacheheader_t   expected;
+    dboolean        result = false;
+
+    free(filename);
+
+    if (file)
+    {
+        M_CacheHeader(&expected, key, length);
+        result = (fread(&header, 1, sizeof(header), file) == sizeof(header)
+            && !memcmp(&header, &expected, sizeof(header))
+            && fread(data, 1, length, file) == length);
+        fclose(file);
+    }
+
+    if (result)
+        cachehits++;
+    else
+        cachemisses++;
+
+    return result;
+}
+
+void M_WriteCacheFile(const char *name, uint64_t key, const void *data, size_t length)
+{
+    char            *filename = M_CacheFilename(name);
+    FILE            *file = fopen(filename, "wb");
+    cacheheader_t   header;
+
+    if (file)
+    {
+        dboolean    result;
+
+        M_CacheHeader(&header, key, length);
+        result = (fwrite(&header, 1, sizeof(header), file) == sizeof(header) && fwrite(data, 1, length, file) == length);
+        fclose(file);
+
+        // don't leave a truncated file behind
+        if (!result)
+            remove(filename);
+    }
+
+    free(filename);
+}
+
 // Return a newly-malloced string with all the strings given as arguments
 // concatenated together.
 char *M_StringJoin(char *s, ...)
@@ -69,6 +69,14 @@ char *M_GetResourceFolder(void);
 char *M_GetAppDataFolder(void);
 
 char *M_GetExecutableFolder(void);
+
+extern int  cachehits;
+extern int  cachemisses;
+
+uint64_t M_HashData(const void *data, size_t length, uint64_t hash);
+dboolean M_ReadCacheFile(const char *name, uint64_t key, void *data, size_t length);
+void M_WriteCacheFile(const char *name, uint64_t key, const void *data, size_t length);
+
 dboolean M_StrToInt(const char *str, unsigned int *result);
 const char *M_StrCaseStr(const char *haystack, const char *needle);
 void M_StringCopy(char *dest, const char *src, const size_t dest_size);
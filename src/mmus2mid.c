@@ -92,7 +92,6 @@ typedef struct
     char    velocity;
     int     deltaT;
     uint8_t lastEvt;
-    int     alloced;
 } TrackInfo;
 
 // array of info about tracks
@@ -124,12 +123,39 @@ static uint8_t  miditempo[] = { 0x00, 0xFF, 0x51, 0x03, 0x09, 0xA3, 0x1A };
 static uint8_t  midihdr[] = { 'M', 'T', 'h', 'd', 0, 0, 0, 6, 0, 1, 0, 0, 0, 0 };   // header (length 6, format 1)
 static uint8_t  trackhdr[] = { 'M', 'T', 'r', 'k' };                                // track header
 
+//
+// TReserve()
+//
+// make sure the selected MIDItrack has room for size more bytes
+// if track allocation exceeded, double it until it fits
+// if track not allocated, initially allocate TRACKBUFFERSIZE bytes
+//
+// Allocations are kept from one conversion to the next, so once the
+// tracks have grown large enough no more memory is allocated.
+//
+static void TReserve(MIDI *mididata, int MIDItrack, size_t size)
+{
+    const size_t    needed = mididata->track[MIDItrack].len + size;
+    size_t          alloced = mididata->track[MIDItrack].alloced;
+
+    if (needed <= alloced)
+        return;
+
+    // double allocation or set initial TRACKBUFFERSIZE
+    if (!alloced)
+        alloced = TRACKBUFFERSIZE;
+
+    while (alloced < needed)
+        alloced *= 2;
+
+    mididata->track[MIDItrack].data = (unsigned char *)I_Realloc(mididata->track[MIDItrack].data, alloced);
+    mididata->track[MIDItrack].alloced = alloced;
+}
+
 //
 // TWriteByte()
 //
 // write one byte to the selected MIDItrack, update current position
-// if track allocation exceeded, double it
-// if track not allocated, initially allocate TRACKBUFFERSIZE bytes
 //
 // Passed pointer to Allegro MIDI structure, number of the MIDI track being
 // written, and the byte to write.
@@ -140,15 +166,8 @@ static void TWriteByte(MIDI *mididata, int MIDItrack, unsigned char byte)
 {
     size_t  pos = mididata->track[MIDItrack].len;
 
-    // proff: Added typecast to avoid warning
-    if (pos >= (size_t)track[MIDItrack].alloced)
-    {
-        // double allocation or set initial TRACKBUFFERSIZE
-        track[MIDItrack].alloced = (track[MIDItrack].alloced ? 2 * track[MIDItrack].alloced : TRACKBUFFERSIZE);
-
-        // attempt to reallocate
-        mididata->track[MIDItrack].data = (unsigned char *)I_Realloc(mididata->track[MIDItrack].data, track[MIDItrack].alloced);
-    }
+    if (pos >= mididata->track[MIDItrack].alloced)
+        TReserve(mididata, MIDItrack, 1);
 
     mididata->track[MIDItrack].data[pos] = byte;
     mididata->track[MIDItrack].len++;
@@ -343,10 +362,7 @@ dboolean mmus2mid(uint8_t *mus, size_t size, MIDI *mididata)
         track[i].velocity = 64;
         track[i].deltaT = 0;
         track[i].lastEvt = 0;
-        free(mididata->track[i].data);      // jff 3/5/98 remove old allocations
-        mididata->track[i].data = NULL;
-        track[i].alloced = 0;
-        mididata->track[i].len = 0;
+        mididata->track[i].len = 0;         // reuse the last song's allocations
     }
 
     // allocate the first track which is a special tempo/key track
@@ -356,7 +372,7 @@ dboolean mmus2mid(uint8_t *mus, size_t size, MIDI *mididata)
     mididata->divisions = 89;
 
     // allocate for midi tempo/key track, allow for end of track
-    mididata->track[0].data = (unsigned char *)I_Realloc(mididata->track[0].data, sizeof(midikey) + sizeof(miditempo) + 4);
+    TReserve(mididata, 0, sizeof(midikey) + sizeof(miditempo) + 4);
 
     // key C major
     memcpy(mididata->track[0].data, midikey, sizeof(midikey));
@@ -501,26 +517,15 @@ dboolean mmus2mid(uint8_t *mus, size_t size, MIDI *mididata)
     if (evt != SCORE_END)
         return false;
 
-    // Now add an end of track to each mididata track, correct allocation
+    // Now add an end of track to each mididata track
     for (int i = 0; i < MIDI_TRACKS; i++)
-    {
         if (mididata->track[i].len)
         {
             TWriteByte(mididata, i, 0x00);
             TWriteByte(mididata, i, 0xFF);
             TWriteByte(mididata, i, 0x2F);
             TWriteByte(mididata, i, 0x00);
-
-            // jff 1/23/98 fix failure to set data NULL, len 0 for unused tracks
-            // shorten allocation to proper length (important for Allegro)
-            mididata->track[i].data = (unsigned char *)I_Realloc(mididata->track[i].data, mididata->track[i].len);
         }
-        else
-        {
-            free(mididata->track[i].data);
-            mididata->track[i].data = NULL;
-        }
-    }
 
     return true;
 }
@@ -562,9 +567,11 @@ void FreeMIDIData(MIDI *mididata)
 // in memory. It is used to support memory MUS -> MIDI conversion
 //
 // Passed a pointer to an Allegro MIDI structure, a pointer to a pointer to
-// a buffer containing midi data, and a pointer to a length return.
+// a buffer containing midi data, a pointer to the size of that buffer, and
+// a pointer to a length return. The buffer is only reallocated if it is too
+// small, so it can be reused from one song to the next.
 //
-void MIDIToMidi(const MIDI *mididata, uint8_t **mid, int *midlen)
+void MIDIToMidi(const MIDI *mididata, uint8_t **mid, size_t *midsize, int *midlen)
 {
     uint8_t ntrks = 0;
     uint8_t *midiptr;
@@ -579,8 +586,11 @@ void MIDIToMidi(const MIDI *mididata, uint8_t **mid, int *midlen)
             ntrks++;
         }
 
-    if (!(*mid = (uint8_t *)malloc(total)))
-        return;
+    if (total > *midsize)
+    {
+        *mid = (uint8_t *)I_Realloc(*mid, total);
+        *midsize = total;
+    }
 
     // fill in number of tracks and big endian divisions (tics/qnote)
     midihdr[10] = 0;
@@ -51,12 +51,13 @@ typedef struct                          // a midi file
     {
         unsigned char   *data;          // MIDI message stream
         size_t          len;            // length of the track data
+        size_t          alloced;        // size of the buffer allocated for it
     } track[MIDI_TRACKS];
 } MIDI;
 
 dboolean mmuscheckformat(uint8_t *mus, int size);
 dboolean mmus2mid(uint8_t *mus, size_t size, MIDI *mididata);
-void MIDIToMidi(const MIDI *mididata, uint8_t **mid, int *midlen);
+void MIDIToMidi(const MIDI *mididata, uint8_t **mid, size_t *midsize, int *midlen);
 void FreeMIDIData(MIDI *mididata);
 
 #endif
@@ -1351,80 +1351,76 @@ void A_VileChase(mobj_t *actor, player_t *player, pspdef_t *psp)
         yl = P_GetSafeBlockY(viletryy - bmaporgy - MAXRADIUS * 2);
         yh = P_GetSafeBlockY(viletryy - bmaporgy + MAXRADIUS * 2);
 
-        for (int bx = xl; bx <= xh; bx++)
-            for (int by = yl; by <= yh; by++)
+        // Call PIT_VileCheck() to check whether object is a corpse that can be raised.
+        if (!P_BlockThingsIterator(xl, yl, xh, yh, &PIT_VileCheck))
+        {
+            // got one!
+            mobj_t      *prevtarget = actor->target;
+            mobjinfo_t  *info = corpsehit->info;
+
+            actor->target = corpsehit;
+            A_FaceTarget(actor, NULL, NULL);
+            actor->target = prevtarget;
+
+            P_SetMobjState(actor, S_VILE_HEAL1);
+            S_StartSound(corpsehit, sfx_slop);
+
+            P_SetMobjState(corpsehit, info->raisestate);
+
+            // [BH] fix <https://doomwiki.org/wiki/Ghost_monster>
+            corpsehit->height = info->height;
+            corpsehit->radius = info->radius;
+
+            // killough 07/18/98: friendliness is transferred from AV to raised corpse
+            corpsehit->flags = ((info->flags & ~MF_FRIEND) | (actor->flags & MF_FRIEND));
+
+            corpsehit->flags2 = info->flags2;
+            corpsehit->health = info->spawnhealth;
+            corpsehit->shadowoffset = info->shadowoffset;
+            P_SetTarget(&corpsehit->target, NULL);
+
+            // killough 09/09/98
+            P_SetTarget(&corpsehit->lastenemy, NULL);
+            corpsehit->flags &= ~MF_JUSTHIT;
+
+            viewplayer->killcount--;
+            stat_monsterskilled--;
+            P_UpdateKillStat(corpsehit->type, -1);
+
+            // [BH] display an obituary message in the console
+            if (con_obituaries)
             {
-                // Call PIT_VileCheck() to check whether object is a corpse that can be raised.
-                if (!P_BlockThingsIterator(bx, by, &PIT_VileCheck))
-                {
-                    // got one!
-                    mobj_t      *prevtarget = actor->target;
-                    mobjinfo_t  *info = corpsehit->info;
-
-                    actor->target = corpsehit;
-                    A_FaceTarget(actor, NULL, NULL);
-                    actor->target = prevtarget;
-
-                    P_SetMobjState(actor, S_VILE_HEAL1);
-                    S_StartSound(corpsehit, sfx_slop);
-
-                    P_SetMobjState(corpsehit, info->raisestate);
-
-                    // [BH] fix <https://doomwiki.org/wiki/Ghost_monster>
-                    corpsehit->height = info->height;
-                    corpsehit->radius = info->radius;
-
-                    // killough 07/18/98: friendliness is transferred from AV to raised corpse
-                    corpsehit->flags = ((info->flags & ~MF_FRIEND) | (actor->flags & MF_FRIEND));
-
-                    corpsehit->flags2 = info->flags2;
-                    corpsehit->health = info->spawnhealth;
-                    corpsehit->shadowoffset = info->shadowoffset;
-                    P_SetTarget(&corpsehit->target, NULL);
-
-                    // killough 09/09/98
-                    P_SetTarget(&corpsehit->lastenemy, NULL);
-                    corpsehit->flags &= ~MF_JUSTHIT;
-
-                    viewplayer->killcount--;
-                    stat_monsterskilled--;
-                    P_UpdateKillStat(corpsehit->type, -1);
-
-                    // [BH] display an obituary message in the console
-                    if (con_obituaries)
-                    {
-                        char    actorname[33];
-                        char    corpsehitname[33];
-                        char    *temp;
-
-                        if (*actor->name)
-                            M_StringCopy(actorname, actor->name, sizeof(actorname));
-                        else
-                            M_snprintf(actorname, sizeof(actorname), "%s %s%s",
-                                ((actor->flags & MF_FRIEND) && monstercount[actor->type] == 1 ? "the" :
-                                    (isvowel(actor->info->name1[0]) ? "an" : "a")),
-                                ((actor->flags & MF_FRIEND) ? "friendly " : ""),
-                                (*actor->info->name1 ? actor->info->name1 : "monster"));
-
-                        temp = sentencecase(actorname);
-
-                        if (*corpsehit->name)
-                            M_StringCopy(corpsehitname, corpsehit->name, sizeof(corpsehitname));
-                        else
-                            M_snprintf(corpsehitname, sizeof(corpsehitname), "%s dead%s%s",
-                                ((corpsehit->flags & MF_FRIEND) && monstercount[corpsehit->type] == 1 ? "the" : "a"),
-                                ((corpsehit->flags & MF_FRIEND) ? ", friendly " : " "),
-                                (*corpsehit->info->name1 ? corpsehit->info->name1 : "monster"));
-
-                        C_PlayerObituary("%s resurrected %s.", temp, corpsehitname);
-                        free(temp);
-                    }
-
-                    // killough 08/29/98: add to appropriate thread
-                    P_UpdateThinker(&corpsehit->thinker);
-                    return;
-                }
+                char    actorname[33];
+                char    corpsehitname[33];
+                char    *temp;
+
+                if (*actor->name)
+                    M_StringCopy(actorname, actor->name, sizeof(actorname));
+                else
+                    M_snprintf(actorname, sizeof(actorname), "%s %s%s",
+                        ((actor->flags & MF_FRIEND) && monstercount[actor->type] == 1 ? "the" :
+                            (isvowel(actor->info->name1[0]) ? "an" : "a")),
+                        ((actor->flags & MF_FRIEND) ? "friendly " : ""),
+                        (*actor->info->name1 ? actor->info->name1 : "monster"));
+
+                temp = sentencecase(actorname);
+
+                if (*corpsehit->name)
+                    M_StringCopy(corpsehitname, corpsehit->name, sizeof(corpsehitname));
+                else
+                    M_snprintf(corpsehitname, sizeof(corpsehitname), "%s dead%s%s",
+                        ((corpsehit->flags & MF_FRIEND) && monstercount[corpsehit->type] == 1 ? "the" : "a"),
+                        ((corpsehit->flags & MF_FRIEND) ? ", friendly " : " "),
+                        (*corpsehit->info->name1 ? corpsehit->info->name1 : "monster"));
+
+                C_PlayerObituary("%s resurrected %s.", temp, corpsehitname);
+                free(temp);
             }
+
+            // killough 08/29/98: add to appropriate thread
+            P_UpdateThinker(&corpsehit->thinker);
+            return;
+        }
     }
 
     // Return to normal attack.
@@ -36,6 +36,9 @@
 ========================================================================
 */
 
+#include <stdlib.h>
+
+#include "doomstat.h"
 #include "p_fix.h"
 #include "r_defs.h"
 
@@ -1736,3 +1739,102 @@ thingfix_t thingfix[] =
 
     { -1,               0,   0,     0, 0,                      DEFAULT, DEFAULT, DEFAULT, DEFAULT, DEFAULT, DEFAULT                            }
 };
+
+fixindex_t  vertexfixes = { vertexfix, sizeof(vertexfix_t) };
+fixindex_t  linefixes = { linefix, sizeof(linefix_t) };
+fixindex_t  sectorfixes = { sectorfix, sizeof(sectorfix_t) };
+fixindex_t  thingfixes = { thingfix, sizeof(thingfix_t) };
+
+enum
+{
+    KEY_MISSION,
+    KEY_EPISODE,
+    KEY_MAP,
+    KEY_ID,
+    NUMKEYS
+};
+
+static fixindex_t   *sortindex;
+
+static const int *P_FixKey(const fixindex_t *index, int fix)
+{
+    return (const int *)((const byte *)index->table + fix * index->size);
+}
+
+static int P_CompareKeys(const int *key1, const int *key2)
+{
+    for (int i = 0; i < NUMKEYS; i++)
+        if (key1[i] != key2[i])
+            return (key1[i] < key2[i] ? -1 : 1);
+
+    return 0;
+}
+
+static int P_CompareFixes(const void *a, const void *b)
+{
+    const int   fix1 = *(const int *)a;
+    const int   fix2 = *(const int *)b;
+    const int   result = P_CompareKeys(P_FixKey(sortindex, fix1), P_FixKey(sortindex, fix2));
+
+    // keep fixes for the same entity in the order they're listed
+    return (result ? result : fix1 - fix2);
+}
+
+static void P_InitFixIndex(fixindex_t *index)
+{
+    index->count = 0;
+
+    while (P_FixKey(index, index->count)[KEY_MISSION] != -1)
+        index->count++;
+
+    index->order = malloc(MAX(index->count, 1) * sizeof(int));
+    index->position = malloc(MAX(index->count, 1) * sizeof(int));
+
+    for (int i = 0; i < index->count; i++)
+        index->order[i] = i;
+
+    sortindex = index;
+    qsort(index->order, index->count, sizeof(int), &P_CompareFixes);
+
+    for (int i = 0; i < index->count; i++)
+        index->position[index->order[i]] = i;
+}
+
+void P_InitFixes(void)
+{
+    P_InitFixIndex(&vertexfixes);
+    P_InitFixIndex(&linefixes);
+    P_InitFixIndex(&sectorfixes);
+    P_InitFixIndex(&thingfixes);
+}
+
+int P_FirstFix(fixindex_t *index, int id)
+{
+    const int   key[NUMKEYS] = { gamemission, gameepisode, gamemap, id };
+    int         low = 0;
+    int         high = index->count;
+
+    if (gamemode == shareware)
+        return -1;
+
+    // find the first fix with a key that isn't less than this one
+    while (low < high)
+    {
+        const int   mid = (low + high) / 2;
+
+        if (P_CompareKeys(P_FixKey(index, index->order[mid]), key) < 0)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+
+    return (low < index->count && !P_CompareKeys(P_FixKey(index, index->order[low]), key) ? index->order[low] : -1);
+}
+
+int P_NextFix(fixindex_t *index, int fix)
+{
+    const int   next = index->position[fix] + 1;
+
+    return (next < index->count && !P_CompareKeys(P_FixKey(index, index->order[next]), P_FixKey(index, fix)) ?
+        index->order[next] : -1);
+}
@@ -111,4 +111,32 @@ typedef struct
 
 extern thingfix_t   thingfix[];
 
+// Each table of fixes is indexed by P_InitFixes() so that the fixes for
+// an entity in the current map can be found with a binary search rather
+// than by scanning the whole table. Every fix_t above starts with the
+// mission, episode, map and entity number, which form the key.
+typedef struct
+{
+    void    *table;
+    size_t  size;
+    int     count;
+    int     *order;
+    int     *position;
+} fixindex_t;
+
+extern fixindex_t   vertexfixes;
+extern fixindex_t   linefixes;
+extern fixindex_t   sectorfixes;
+extern fixindex_t   thingfixes;
+
+void P_InitFixes(void);
+
+// Returns the first fix in the table for entity id in the current map,
+// or -1 if there isn't one
+int P_FirstFix(fixindex_t *index, int id);
+
+// Returns the next fix for the same entity in the current map as fix,
+// or -1 if there isn't one
+int P_NextFix(fixindex_t *index, int fix);
+
 #endif
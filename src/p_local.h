@@ -203,7 +203,7 @@ extern fixed_t  lowfloor;
 void P_LineOpening(line_t *line);
 
 dboolean P_BlockLinesIterator(int x, int y, dboolean func(line_t *));
-dboolean P_BlockThingsIterator(int x, int y, dboolean func(mobj_t *));
+dboolean P_BlockThingsIterator(int xl, int yl, int xh, int yh, dboolean func(mobj_t *));
 
 #define PT_ADDLINES     1
 #define PT_ADDTHINGS    2
@@ -219,6 +219,9 @@ void P_SetBloodSplatPosition(bloodsplat_t *splat);
 
 void P_CheckIntercepts(void);
 
+void P_ClearBlockThings(void);
+void P_FreeBlockThings(void);
+
 //
 // P_MAP.C
 //
@@ -269,14 +272,21 @@ void P_MapEnd(void);
 //
 // P_SETUP.C
 //
+typedef struct
+{
+    mobj_t          **mobjs;
+    int             nummobjs;
+    int             maxmobjs;
+} blockthings_t;
+
 extern const byte   *rejectmatrix;  // for fast sight rejection
-extern int          *blockmaplump;
-extern int          *blockmap;
+extern int          *blockmap;      // start of each block in blocklines
+extern line_t       **blocklines;
 extern int          bmapwidth;
 extern int          bmapheight;     // in mapblocks
 extern fixed_t      bmaporgx;
 extern fixed_t      bmaporgy;       // origin of block map
-extern mobj_t       **blocklinks;   // for thing chains
+extern blockthings_t *blockthings; // for things overlapping each block
 
 // MAES: extensions to support 512x512 blockmaps.
 extern int          blockmapxneg;
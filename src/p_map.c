@@ -247,15 +247,13 @@ dboolean P_TeleportMove(mobj_t *thing, fixed_t x, fixed_t y, fixed_t z, dboolean
     numspechit = 0;
 
     // stomp on any things contacted
-    xl = P_GetSafeBlockX(tmbbox[BOXLEFT] - bmaporgx - MAXRADIUS);
-    xh = P_GetSafeBlockX(tmbbox[BOXRIGHT] - bmaporgx + MAXRADIUS);
-    yl = P_GetSafeBlockY(tmbbox[BOXBOTTOM] - bmaporgy - MAXRADIUS);
-    yh = P_GetSafeBlockY(tmbbox[BOXTOP] - bmaporgy + MAXRADIUS);
+    xl = P_GetSafeBlockX(tmbbox[BOXLEFT] - bmaporgx);
+    xh = P_GetSafeBlockX(tmbbox[BOXRIGHT] - bmaporgx);
+    yl = P_GetSafeBlockY(tmbbox[BOXBOTTOM] - bmaporgy);
+    yh = P_GetSafeBlockY(tmbbox[BOXTOP] - bmaporgy);
 
-    for (int bx = xl; bx <= xh; bx++)
-        for (int by = yl; by <= yh; by++)
-            if (!P_BlockThingsIterator(bx, by, &PIT_StompThing))
-                return false;
+    if (!P_BlockThingsIterator(xl, yl, xh, yh, &PIT_StompThing))
+        return false;
 
     // the move is ok,
     // so link the thing into its new position
@@ -787,21 +785,18 @@ dboolean P_CheckPosition(mobj_t *thing, fixed_t x, fixed_t y)
         return true;
 
     // Check things first, possibly picking things up.
-    // The bounding box is extended by MAXRADIUS
-    // because mobj_ts are grouped into mapblocks
-    // based on their origin point, and can overlap
-    // into adjacent blocks by up to MAXRADIUS units.
-    xl = P_GetSafeBlockX(tmbbox[BOXLEFT] - bmaporgx - MAXRADIUS);
-    xh = P_GetSafeBlockX(tmbbox[BOXRIGHT] - bmaporgx + MAXRADIUS);
-    yl = P_GetSafeBlockY(tmbbox[BOXBOTTOM] - bmaporgy - MAXRADIUS);
-    yh = P_GetSafeBlockY(tmbbox[BOXTOP] - bmaporgy + MAXRADIUS);
+    // mobj_ts are linked into every mapblock their
+    // bounding box overlaps, so only the blocks
+    // touched by the bounding box need checking.
+    xl = P_GetSafeBlockX(tmbbox[BOXLEFT] - bmaporgx);
+    xh = P_GetSafeBlockX(tmbbox[BOXRIGHT] - bmaporgx);
+    yl = P_GetSafeBlockY(tmbbox[BOXBOTTOM] - bmaporgy);
+    yh = P_GetSafeBlockY(tmbbox[BOXTOP] - bmaporgy);
 
     validcount++;
 
-    for (int bx = xl; bx <= xh; bx++)
-        for (int by = yl; by <= yh; by++)
-            if (!P_BlockThingsIterator(bx, by, &PIT_CheckThing))
-                return false;
+    if (!P_BlockThingsIterator(xl, yl, xh, yh, &PIT_CheckThing))
+        return false;
 
     // check lines
     if ((thing->flags & MF_SPECIAL) && !(thing->flags & MF_DROPPED))
@@ -921,21 +916,18 @@ mobj_t *P_CheckOnMobj(mobj_t *thing)
         return NULL;
 
     // check things first, possibly picking things up
-    // the bounding box is extended by MAXRADIUS because mobj_ts are grouped
-    // into mapblocks based on their origin point, and can overlap into adjacent
-    // blocks by up to MAXRADIUS units
-    xl = P_GetSafeBlockX(tmbbox[BOXLEFT] - bmaporgx - MAXRADIUS);
-    xh = P_GetSafeBlockX(tmbbox[BOXRIGHT] - bmaporgx + MAXRADIUS);
-    yl = P_GetSafeBlockY(tmbbox[BOXBOTTOM] - bmaporgy - MAXRADIUS);
-    yh = P_GetSafeBlockY(tmbbox[BOXTOP] - bmaporgy + MAXRADIUS);
+    // mobj_ts are linked into every mapblock their bounding box overlaps,
+    // so only the blocks touched by the bounding box need checking
+    xl = P_GetSafeBlockX(tmbbox[BOXLEFT] - bmaporgx);
+    xh = P_GetSafeBlockX(tmbbox[BOXRIGHT] - bmaporgx);
+    yl = P_GetSafeBlockY(tmbbox[BOXBOTTOM] - bmaporgy);
+    yh = P_GetSafeBlockY(tmbbox[BOXTOP] - bmaporgy);
 
-    for (int bx = xl; bx <= xh; bx++)
-        for (int by = yl; by <= yh; by++)
-            if (!P_BlockThingsIterator(bx, by, &PIT_CheckOnMobjZ))
-            {
-                *tmthing = oldmo;
-                return onmobj;
-            }
+    if (!P_BlockThingsIterator(xl, yl, xh, yh, &PIT_CheckOnMobjZ))
+    {
+        *tmthing = oldmo;
+        return onmobj;
+    }
 
     *tmthing = oldmo;
     return NULL;
@@ -1985,7 +1977,7 @@ dboolean PIT_RadiusAttack(mobj_t *thing)
 //
 void P_RadiusAttack(mobj_t *spot, mobj_t *source, int damage, dboolean verticality)
 {
-    fixed_t dist = (damage << FRACBITS) + MAXRADIUS;
+    fixed_t dist = damage << FRACBITS;
     int     xh = P_GetSafeBlockX(spot->x + dist - bmaporgx);
     int     xl = P_GetSafeBlockX(spot->x - dist - bmaporgx);
     int     yh = P_GetSafeBlockY(spot->y + dist - bmaporgy);
@@ -1996,9 +1988,7 @@ void P_RadiusAttack(mobj_t *spot, mobj_t *source, int damage, dboolean verticali
     bombdamage = damage;
     bombverticality = verticality;
 
-    for (int y = yl; y <= yh; y++)
-        for (int x = xl; x <= xh; x++)
-            P_BlockThingsIterator(x, y, &PIT_RadiusAttack);
+    P_BlockThingsIterator(xl, yl, xh, yh, &PIT_RadiusAttack);
 }
 
 //
@@ -217,18 +217,24 @@ void P_UnsetThingPosition(mobj_t *thing)
     {
         // inert things don't need to be in blockmap
         //
-        // killough 08/11/98: simpler scheme using pointers-to-pointers for prev
-        // pointers, allows head node pointers to be treated like everything else
-        //
-        // Also more robust, since it doesn't depend on current position for
-        // unlinking. Old method required computing head node based on position
-        // at time of unlinking, assuming it was the same position as during
-        // linking.
-        mobj_t  *bnext;
-        mobj_t  **bprev = thing->bprev;
-
-        if (bprev && (*bprev = bnext = thing->bnext))   // unlink from block map
-            bnext->bprev = bprev;
+        // Remove the thing from every block it was linked into. The range is
+        // stored in the thing itself, so unlinking doesn't depend on its
+        // current position.
+        for (int y = thing->blockyl; y <= thing->blockyh; y++)
+            for (int x = thing->blockxl; x <= thing->blockxh; x++)
+            {
+                blockthings_t   *block = &blockthings[y * bmapwidth + x];
+
+                for (int i = 0; i < block->nummobjs; i++)
+                    if (block->mobjs[i] == thing)
+                    {
+                        block->mobjs[i] = block->mobjs[--block->nummobjs];
+                        break;
+                    }
+            }
+
+        thing->blockxl = 0;
+        thing->blockxh = -1;
     }
 }
 
@@ -293,27 +299,56 @@ void P_SetThingPosition(mobj_t *thing)
     if (!(thing->flags & MF_NOBLOCKMAP))
     {
         // inert things don't need to be in blockmap
-        int blockx = P_GetSafeBlockX(thing->x - bmaporgx);
-        int blocky = P_GetSafeBlockY(thing->y - bmaporgy);
-
-        if (blockx >= 0 && blockx < bmapwidth && blocky >= 0 && blocky < bmapheight)
+        //
+        // Link the thing into every block its bounding box overlaps, so block
+        // iterators don't need to look into adjacent blocks for things whose
+        // origin is elsewhere. PIT_CheckThing() uses the pickup radius of
+        // items, so that is accounted for too.
+        mobjinfo_t  *info = thing->info;
+        fixed_t     radius = MAX(thing->radius, MAX(info->radius, info->pickupradius));
+        int         xl = P_GetSafeBlockX(thing->x - radius - bmaporgx);
+        int         xh = P_GetSafeBlockX(thing->x + radius - bmaporgx);
+        int         yl = P_GetSafeBlockY(thing->y - radius - bmaporgy);
+        int         yh = P_GetSafeBlockY(thing->y + radius - bmaporgy);
+
+        // MAES: a 512x512 blockmap may wrap the left and bottom edges
+        if (xl > xh)
+            xl = 0;
+
+        if (yl > yh)
+            yl = 0;
+
+        xl = MAX(0, xl);
+        xh = MIN(xh, bmapwidth - 1);
+        yl = MAX(0, yl);
+        yh = MIN(yh, bmapheight - 1);
+
+        if (xl <= xh && yl <= yh)
         {
-            // killough 08/11/98: simpler scheme using pointer-to-pointer prev
-            // pointers, allows head nodes to be treated like everything else
-            mobj_t  **link = &blocklinks[blocky * bmapwidth + blockx];
-            mobj_t  *bnext = *link;
+            for (int y = yl; y <= yh; y++)
+                for (int x = xl; x <= xh; x++)
+                {
+                    blockthings_t   *block = &blockthings[y * bmapwidth + x];
 
-            if ((thing->bnext = bnext))
-                bnext->bprev = &thing->bnext;
+                    if (block->nummobjs == block->maxmobjs)
+                    {
+                        block->maxmobjs = (block->maxmobjs ? block->maxmobjs * 2 : 8);
+                        block->mobjs = I_Realloc(block->mobjs, block->maxmobjs * sizeof(*block->mobjs));
+                    }
 
-            thing->bprev = link;
-            *link = thing;
+                    block->mobjs[block->nummobjs++] = thing;
+                }
+
+            thing->blockxl = xl;
+            thing->blockxh = xh;
+            thing->blockyl = yl;
+            thing->blockyh = yh;
         }
         else
         {
             // thing is off the map
-            thing->bnext = NULL;
-            thing->bprev = NULL;
+            thing->blockxl = 0;
+            thing->blockxh = -1;
         }
     }
 }
@@ -355,14 +390,13 @@ dboolean P_BlockLinesIterator(int x, int y, dboolean func(line_t *))
         return true;
     else
     {
-        const int   *list = &blockmaplump[blockmap[y * bmapwidth + x]];
-
-        if (skipblstart)
-            list++;
+        const int   block = y * bmapwidth + x;
+        line_t      **list = blocklines + blockmap[block];
+        line_t      **end = blocklines + blockmap[block + 1];
 
-        for (; *list != -1; list++)
+        for (; list < end; list++)
         {
-            line_t  *ld = lines + *list;
+            line_t  *ld = *list;
 
             if (ld->validcount == validcount)
                 continue;       // line has already been checked
@@ -379,78 +413,95 @@ dboolean P_BlockLinesIterator(int x, int y, dboolean func(line_t *))
 
 //
 // P_BlockThingsIterator
-//
-dboolean P_BlockThingsIterator(int x, int y, dboolean func(mobj_t *))
+// Calls the passed PIT_* function once for each thing
+// overlapping the given range of mapblocks.
+// The things are collected before any are passed to the
+// function, so it may safely move or remove things, or
+// start another iteration of its own.
+//
+static mobj_t   **blockthingslist;
+static int      blockthingslistsize;
+static int      numblockthingslist;
+static int      blockvalidcount;
+
+dboolean P_BlockThingsIterator(int xl, int yl, int xh, int yh, dboolean func(mobj_t *))
 {
-    if (x < 0 || y < 0 || x >= bmapwidth || y >= bmapheight)
-        return true;
+    int         start = numblockthingslist;
+    dboolean    result = true;
+
+    xl = MAX(0, xl);
+    xh = MIN(xh, bmapwidth - 1);
+    yl = MAX(0, yl);
+    yh = MIN(yh, bmapheight - 1);
+
+    blockvalidcount++;
+
+    for (int x = xl; x <= xh; x++)
+        for (int y = yl; y <= yh; y++)
+        {
+            blockthings_t   *block = &blockthings[y * bmapwidth + x];
+
+            for (int i = 0; i < block->nummobjs; i++)
+            {
+                mobj_t  *mobj = block->mobjs[i];
+
+                if (mobj->blockvalidcount == blockvalidcount)
+                    continue;   // thing overlaps a block already checked
+
+                mobj->blockvalidcount = blockvalidcount;
+
+                if (numblockthingslist == blockthingslistsize)
+                {
+                    blockthingslistsize = (blockthingslistsize ? blockthingslistsize * 2 : 128);
+                    blockthingslist = I_Realloc(blockthingslist, blockthingslistsize * sizeof(*blockthingslist));
+                }
+
+                blockthingslist[numblockthingslist++] = mobj;
+            }
+        }
+
+    for (int i = start, end = numblockthingslist; i < end; i++)
+    {
+        mobj_t  *mobj = blockthingslist[i];
+
+        if (mobj->blockxl > mobj->blockxh)
+            continue;           // thing was unlinked by an earlier call
 
-    for (mobj_t *mobj = blocklinks[y * bmapwidth + x]; mobj; mobj = mobj->bnext)
         if (!func(mobj))
-            return false;
+        {
+            result = false;
+            break;
+        }
+    }
 
-    if (func == &PIT_RadiusAttack)
-        return true;
+    numblockthingslist = start;
+    return result;
+}
 
-    // Blockmap bug fix by Terry Hearst
-
-    // (-1, -1)
-    if (x > 0 && y > 0)
-        for (mobj_t *mobj = blocklinks[(y - 1) * bmapwidth + x - 1]; mobj; mobj = mobj->bnext)
-            if (x == (mobj->x + mobj->radius - bmaporgx) >> MAPBLOCKSHIFT
-                && y == (mobj->y + mobj->radius - bmaporgy) >> MAPBLOCKSHIFT
-                && !func(mobj))
-                    return false;
-
-    // (0, -1)
-    if (y > 0)
-        for (mobj_t *mobj = blocklinks[(y - 1) * bmapwidth + x]; mobj; mobj = mobj->bnext)
-            if (y == (mobj->y + mobj->radius - bmaporgy) >> MAPBLOCKSHIFT && !func(mobj))
-                    return false;
-
-    // (1, -1)
-    if (x < bmapwidth - 1 && y > 0)
-        for (mobj_t *mobj = blocklinks[(y - 1) * bmapwidth + x + 1]; mobj; mobj = mobj->bnext)
-            if (x == (mobj->x - mobj->radius - bmaporgx) >> MAPBLOCKSHIFT
-                && y == (mobj->y + mobj->radius - bmaporgy) >> MAPBLOCKSHIFT
-                && !func(mobj))
-                    return false;
-
-    // (1, 0)
-    if (x < bmapwidth - 1)
-        for (mobj_t *mobj = blocklinks[y * bmapwidth + x + 1]; mobj; mobj = mobj->bnext)
-            if (x == (mobj->x - mobj->radius - bmaporgx) >> MAPBLOCKSHIFT && !func(mobj))
-                    return false;
-
-    // (1, 1)
-    if (x < bmapwidth - 1 && y < bmapheight - 1)
-        for (mobj_t *mobj = blocklinks[(y + 1) * bmapwidth + x + 1]; mobj; mobj = mobj->bnext)
-            if (x == (mobj->x - mobj->radius - bmaporgx) >> MAPBLOCKSHIFT
-                && y == (mobj->y - mobj->radius - bmaporgy) >> MAPBLOCKSHIFT
-                && !func(mobj))
-                    return false;
-
-    // (0, 1)
-    if (y < bmapheight - 1)
-        for (mobj_t *mobj = blocklinks[(y + 1) * bmapwidth + x]; mobj; mobj = mobj->bnext)
-            if (y == (mobj->y - mobj->radius - bmaporgy) >> MAPBLOCKSHIFT && !func(mobj))
-                    return false;
-
-    // (-1, 1)
-    if (x > 0 && y < bmapheight - 1)
-        for (mobj_t *mobj = blocklinks[(y + 1) * bmapwidth + x - 1]; mobj; mobj = mobj->bnext)
-            if (x == (mobj->x + mobj->radius - bmaporgx) >> MAPBLOCKSHIFT
-                && y == (mobj->y - mobj->radius - bmaporgy) >> MAPBLOCKSHIFT
-                && !func(mobj))
-                    return false;
-
-    // (-1, 0)
-    if (x > 0)
-        for (mobj_t *mobj = blocklinks[y * bmapwidth + x - 1]; mobj; mobj = mobj->bnext)
-            if (x == (mobj->x + mobj->radius - bmaporgx) >> MAPBLOCKSHIFT && !func(mobj))
-                    return false;
+//
+// P_ClearBlockThings
+// Empties every mapblock, keeping the
+// memory allocated for reuse.
+//
+void P_ClearBlockThings(void)
+{
+    for (int i = 0, count = bmapwidth * bmapheight; i < count; i++)
+        blockthings[i].nummobjs = 0;
+}
 
-    return true;
+//
+// P_FreeBlockThings
+//
+void P_FreeBlockThings(void)
+{
+    if (!blockthings)
+        return;
+
+    for (int i = 0, count = bmapwidth * bmapheight; i < count; i++)
+        free(blockthings[i].mobjs);
+
+    free(blockthings);
+    blockthings = NULL;
 }
 
 //
@@ -621,36 +672,69 @@ static dboolean PIT_AddThingIntercepts(mobj_t *thing)
     return true;
 }
 
+//
+// P_AddBlockThingIntercepts
+// Things overlap every block they touch, so
+// make sure each is only added once per trace.
+//
+static void P_AddBlockThingIntercepts(int x, int y)
+{
+    blockthings_t   *block;
+
+    if (x < 0 || y < 0 || x >= bmapwidth || y >= bmapheight)
+        return;
+
+    block = &blockthings[y * bmapwidth + x];
+
+    for (int i = 0; i < block->nummobjs; i++)
+    {
+        mobj_t  *mobj = block->mobjs[i];
+
+        if (mobj->blockvalidcount != blockvalidcount)
+        {
+            mobj->blockvalidcount = blockvalidcount;
+            PIT_AddThingIntercepts(mobj);
+        }
+    }
+}
+
 //
 // P_TraverseIntercepts
 // Returns true if the traverser function returns true
 // for all lines.
 //
+// Intercepts beyond maxfrac are discarded, and the rest are
+// insertion sorted by distance. As they are added while
+// stepping along the trace through the blockmap, they are
+// already mostly in order, so this is close to linear rather
+// than the O(n^2) of repeatedly scanning for the nearest.
+//
 static dboolean P_TraverseIntercepts(traverser_t func, fixed_t maxfrac)
 {
-    size_t      count = intercept_p - intercepts;
-    intercept_t *in = NULL;
+    intercept_t *end = intercepts;
 
-    while (count--)
+    for (intercept_t *scan = intercepts; scan < intercept_p; scan++)
     {
-        fixed_t dist = FIXED_MAX;
+        intercept_t in;
+        intercept_t *pos;
 
-        for (intercept_t *scan = intercepts; scan < intercept_p; scan++)
-            if (scan->frac < dist)
-            {
-                dist = scan->frac;
-                in = scan;
-            }
+        if (scan->frac > maxfrac)
+            continue;           // out of range
 
-        if (dist > maxfrac)
-            return true;        // checked everything in range
+        in = *scan;
+        pos = end++;
 
-        if (!func(in))
-            return false;       // don't bother going farther
+        // equal distances keep the order they were added in
+        for (; pos > intercepts && (pos - 1)->frac > in.frac; pos--)
+            *pos = *(pos - 1);
 
-        in->frac = FIXED_MAX;
+        *pos = in;
     }
 
+    for (intercept_t *in = intercepts; in < end; in++)
+        if (!func(in))
+            return false;       // don't bother going farther
+
     return true;                // everything was traversed
 }
 
@@ -675,6 +759,7 @@ dboolean P_PathTraverse(fixed_t x1, fixed_t y1, fixed_t x2, fixed_t y2, int flag
     int     mapxstep = 0, mapystep = 0;
 
     validcount++;
+    blockvalidcount++;
     intercept_p = intercepts;
 
     if (!((x1 - bmaporgx) & (MAPBLOCKSIZE - 1)))
@@ -749,8 +834,7 @@ dboolean P_PathTraverse(fixed_t x1, fixed_t y1, fixed_t x2, fixed_t y2, int flag
                 return false;   // early out
 
         if (flags & PT_ADDTHINGS)
-            if (!P_BlockThingsIterator(mapx, mapy, &PIT_AddThingIntercepts))
-                return false;   // early out
+            P_AddBlockThingIntercepts(mapx, mapy);
 
         if (mapx == xt2 && mapy == yt2)
             break;
@@ -790,8 +874,8 @@ dboolean P_PathTraverse(fixed_t x1, fixed_t y1, fixed_t x2, fixed_t y2, int flag
 
                 if (flags & PT_ADDTHINGS)
                 {
-                    P_BlockThingsIterator(mapx + mapxstep, mapy, &PIT_AddThingIntercepts);
-                    P_BlockThingsIterator(mapx, mapy + mapystep, &PIT_AddThingIntercepts);
+                    P_AddBlockThingIntercepts(mapx + mapxstep, mapy);
+                    P_AddBlockThingIntercepts(mapx, mapy + mapystep);
                 }
 
                 xintercept += xstep;
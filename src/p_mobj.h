@@ -381,9 +381,10 @@ typedef struct mobj_s
     int                 frame;                  // might be ORed with FF_FULLBRIGHT
 
     // Interaction info, by BLOCKMAP.
-    // Links in blocks (if needed).
-    struct mobj_s       *bnext;
-    struct mobj_s       **bprev;                // killough 08/11/98: change to ptr-to-ptr
+    // Range of blocks the thing overlaps (if needed).
+    int                 blockxl, blockxh;
+    int                 blockyl, blockyh;
+    int                 blockvalidcount;        // if == blockvalidcount, already collected
 
     struct subsector_s  *subsector;
 
@@ -1398,87 +1398,88 @@ void P_ArchiveSpecials(void)
     button_t    *button = buttonlist;
 
     // save off the current thinkers
-    for (thinker_t *th = thinkers[th_misc].cnext; th != &thinkers[th_misc]; th = th->cnext)
-    {
-        if (th->function == &T_CeilingStay)
-        {
-            for (ceilinglist_t *ceilinglist = activeceilings; ceilinglist; ceilinglist = ceilinglist->next)
-                if (ceilinglist->ceiling == (ceiling_t *)th)
-                {
-                    saveg_write8(tc_ceiling);
-                    saveg_write_ceiling_t((ceiling_t *)th);
-
-                    break;
-                }
-        }
-        else if (th->function == &T_MoveCeiling)
-        {
-            saveg_write8(tc_ceiling);
-            saveg_write_ceiling_t((ceiling_t *)th);
-        }
-        else if (th->function == &T_VerticalDoor)
-        {
-            saveg_write8(tc_door);
-            saveg_write_vldoor_t((vldoor_t *)th);
-        }
-        else if (th->function == &T_MoveFloor)
-        {
-            saveg_write8(tc_floor);
-            saveg_write_floormove_t((floormove_t *)th);
-        }
-        else if (th->function == &T_PlatStay)
-        {
-            // [jeff-d] save height of moving platforms
-            for (platlist_t *platlist = activeplats; platlist; platlist = platlist->next)
-                if (platlist->plat == (plat_t *)th)
-                {
-                    saveg_write8(tc_plat);
-                    saveg_write_plat_t((plat_t *)th);
-
-                    break;
-                }
-        }
-        else if (th->function == &T_PlatRaise)
-        {
-            saveg_write8(tc_plat);
-            saveg_write_plat_t((plat_t *)th);
-        }
-        else if (th->function == &T_LightFlash)
-        {
-            saveg_write8(tc_flash);
-            saveg_write_lightflash_t((lightflash_t *)th);
-        }
-        else if (th->function == &T_StrobeFlash)
-        {
-            saveg_write8(tc_strobe);
-            saveg_write_strobe_t((strobe_t *)th);
-        }
-        else if (th->function == &T_Glow)
-        {
-            saveg_write8(tc_glow);
-            saveg_write_glow_t((glow_t *)th);
-        }
-        else if (th->function == &T_FireFlicker)
-        {
-            saveg_write8(tc_fireflicker);
-            saveg_write_fireflicker_t((fireflicker_t *)th);
-        }
-        else if (th->function == &T_MoveElevator)
-        {
-            saveg_write8(tc_elevator);
-            saveg_write_elevator_t((elevator_t *)th);
-        }
-        else if (th->function == &T_Scroll)
+    for (int thclass = th_mobj + 1; thclass < NUMTHCLASS; thclass++)
+        for (thinker_t *th = thinkers[thclass].cnext; th != &thinkers[thclass]; th = th->cnext)
         {
-            saveg_write8(tc_scroll);
-            saveg_write_scroll_t((scroll_t *)th);
-        }
-        else if (th->function == &T_Pusher)
-        {
-            saveg_write8(tc_pusher);
-            saveg_write_pusher_t((pusher_t *)th);
+            if (th->function == &T_CeilingStay)
+            {
+                for (ceilinglist_t *ceilinglist = activeceilings; ceilinglist; ceilinglist = ceilinglist->next)
+                    if (ceilinglist->ceiling == (ceiling_t *)th)
+                    {
+                        saveg_write8(tc_ceiling);
+                        saveg_write_ceiling_t((ceiling_t *)th);
+
+                        break;
+                    }
+            }
+            else if (th->function == &T_MoveCeiling)
+            {
+                saveg_write8(tc_ceiling);
+                saveg_write_ceiling_t((ceiling_t *)th);
+            }
+            else if (th->function == &T_VerticalDoor)
+            {
+                saveg_write8(tc_door);
+                saveg_write_vldoor_t((vldoor_t *)th);
+            }
+            else if (th->function == &T_MoveFloor)
+            {
+                saveg_write8(tc_floor);
+                saveg_write_floormove_t((floormove_t *)th);
+            }
+            else if (th->function == &T_PlatStay)
+            {
+                // [jeff-d] save height of moving platforms
+                for (platlist_t *platlist = activeplats; platlist; platlist = platlist->next)
+                    if (platlist->plat == (plat_t *)th)
+                    {
+                        saveg_write8(tc_plat);
+                        saveg_write_plat_t((plat_t *)th);
+
+                        break;
+                    }
+            }
+            else if (th->function == &T_PlatRaise)
+            {
+                saveg_write8(tc_plat);
+                saveg_write_plat_t((plat_t *)th);
+            }
+            else if (th->function == &T_LightFlash)
+            {
+                saveg_write8(tc_flash);
+                saveg_write_lightflash_t((lightflash_t *)th);
+            }
+            else if (th->function == &T_StrobeFlash)
+            {
+                saveg_write8(tc_strobe);
+                saveg_write_strobe_t((strobe_t *)th);
+            }
+            else if (th->function == &T_Glow)
+            {
+                saveg_write8(tc_glow);
+                saveg_write_glow_t((glow_t *)th);
+            }
+            else if (th->function == &T_FireFlicker)
+            {
+                saveg_write8(tc_fireflicker);
+                saveg_write_fireflicker_t((fireflicker_t *)th);
+            }
+            else if (th->function == &T_MoveElevator)
+            {
+                saveg_write8(tc_elevator);
+                saveg_write_elevator_t((elevator_t *)th);
+            }
+            else if (th->function == &T_Scroll)
+            {
+                saveg_write8(tc_scroll);
+                saveg_write_scroll_t((scroll_t *)th);
+            }
+            else if (th->function == &T_Pusher)
+            {
+                saveg_write8(tc_pusher);
+                saveg_write_pusher_t((pusher_t *)th);
+            }
         }
-    }
 
     do
     {
@@ -180,18 +180,19 @@ int                 numdecorations;
 int                 bmapwidth;
 int                 bmapheight;
 
-// for large maps, wad is 16bit
+// start of each block's list in blocklines, plus the
+// end of the last one
 int                 *blockmap;
 
-// offsets in blockmap are from here
-int                 *blockmaplump;
+// the lines in each block, stored contiguously
+line_t              **blocklines;
 
 // origin of block map
 fixed_t             bmaporgx;
 fixed_t             bmaporgy;
 
-// for thing chains
-mobj_t              **blocklinks;
+// for things overlapping each block
+blockthings_t       *blockthings;
 
 // MAES: extensions to support 512x512 blockmaps.
 // They represent the maximum negative number which represents
@@ -206,7 +207,7 @@ mobj_t              **blocklinks;
 int                 blockmapxneg = -257;
 int                 blockmapyneg = -257;
 
-dboolean            skipblstart;            // MaxW: Skip initial blocklist short
+static dboolean     skipblstart;            // MaxW: Skip initial blocklist short
 
 // REJECT
 // For fast sight rejection.
@@ -670,10 +671,8 @@ static void P_LoadVertexes(int lump)
 
             // Apply any map-specific fixes.
             if (canmodify && r_fixmaperrors)
-                for (int j = 0; vertexfix[j].mission != -1; j++)
-                    if (gamemission == vertexfix[j].mission && gameepisode == vertexfix[j].episode && gamemap == vertexfix[j].map
-                        && gamemode != shareware && i == vertexfix[j].vertex && vertexes[i].x == vertexfix[j].oldx << FRACBITS
-                        && vertexes[i].y == vertexfix[j].oldy << FRACBITS)
+                for (int j = P_FirstFix(&vertexfixes, i); j >= 0; j = P_NextFix(&vertexfixes, j))
+                    if (vertexes[i].x == vertexfix[j].oldx << FRACBITS && vertexes[i].y == vertexfix[j].oldy << FRACBITS)
                     {
                         char    *temp = commify(vertexfix[j].vertex);
 
@@ -875,9 +874,8 @@ static void P_LoadSegs(int lump)
 
         // [BH] Apply any map-specific fixes.
         if (canmodify && r_fixmaperrors)
-            for (int j = 0; linefix[j].mission != -1; j++)
-                if (gamemission == linefix[j].mission && gameepisode == linefix[j].episode && gamemap == linefix[j].map
-                    && gamemode != shareware && linedefnum == linefix[j].linedef && side == linefix[j].side)
+            for (int j = P_FirstFix(&linefixes, linedefnum); j >= 0; j = P_NextFix(&linefixes, j))
+                if (side == linefix[j].side)
                 {
                     if (*linefix[j].toptexture)
                     {
@@ -1271,93 +1269,91 @@ static void P_LoadSectors(int lump)
 
         // [BH] Apply any level-specific fixes.
         if (canmodify && r_fixmaperrors)
-            for (int j = 0; sectorfix[j].mission != -1; j++)
-                if (gamemission == sectorfix[j].mission && gameepisode == sectorfix[j].episode && gamemap == sectorfix[j].map
-                    && gamemode != shareware && i == sectorfix[j].sector)
+            for (int j = P_FirstFix(&sectorfixes, i); j >= 0; j = P_NextFix(&sectorfixes, j))
+            {
+                if (*sectorfix[j].floorpic)
                 {
-                    if (*sectorfix[j].floorpic)
-                    {
-                        char    *temp = commify(sectorfix[j].sector);
+                    char    *temp = commify(sectorfix[j].sector);
 
-                        C_Warning(2, "The floor texture of sector %s has been changed from " BOLD("%.8s") " to " BOLD("%.8s") ".",
-                            temp, lumpinfo[ss->floorpic + firstflat]->name, sectorfix[j].floorpic);
+                    C_Warning(2, "The floor texture of sector %s has been changed from " BOLD("%.8s") " to " BOLD("%.8s") ".",
+                        temp, lumpinfo[ss->floorpic + firstflat]->name, sectorfix[j].floorpic);
 
-                        ss->floorpic = R_FlatNumForName(sectorfix[j].floorpic);
-                        free(temp);
-                    }
+                    ss->floorpic = R_FlatNumForName(sectorfix[j].floorpic);
+                    free(temp);
+                }
 
-                    if (*sectorfix[j].ceilingpic)
-                    {
-                        char    *temp = commify(sectorfix[j].sector);
+                if (*sectorfix[j].ceilingpic)
+                {
+                    char    *temp = commify(sectorfix[j].sector);
 
-                        C_Warning(2, "The ceiling texture of sector %s has been changed from " BOLD("%.8s") " to " BOLD("%.8s") ".",
-                            temp, lumpinfo[ss->ceilingpic + firstflat]->name, sectorfix[j].ceilingpic);
+                    C_Warning(2, "The ceiling texture of sector %s has been changed from " BOLD("%.8s") " to " BOLD("%.8s") ".",
+                        temp, lumpinfo[ss->ceilingpic + firstflat]->name, sectorfix[j].ceilingpic);
 
-                        ss->ceilingpic = R_FlatNumForName(sectorfix[j].ceilingpic);
-                        free(temp);
-                    }
+                    ss->ceilingpic = R_FlatNumForName(sectorfix[j].ceilingpic);
+                    free(temp);
+                }
 
-                    if (sectorfix[j].floorheight != DEFAULT)
-                    {
-                        char    *temp1 = commify(sectorfix[j].sector);
-                        char    *temp2 = commify(ss->floorheight);
-                        char    *temp3 = commify(sectorfix[j].floorheight);
+                if (sectorfix[j].floorheight != DEFAULT)
+                {
+                    char    *temp1 = commify(sectorfix[j].sector);
+                    char    *temp2 = commify(ss->floorheight);
+                    char    *temp3 = commify(sectorfix[j].floorheight);
 
-                        C_Warning(2, "The floor height of sector %s has been changed from %s to %s.", temp1, temp2, temp3);
+                    C_Warning(2, "The floor height of sector %s has been changed from %s to %s.", temp1, temp2, temp3);
 
-                        ss->floorheight = sectorfix[j].floorheight << FRACBITS;
-                        free(temp1);
-                        free(temp2);
-                        free(temp3);
-                    }
+                    ss->floorheight = sectorfix[j].floorheight << FRACBITS;
+                    free(temp1);
+                    free(temp2);
+                    free(temp3);
+                }
 
-                    if (sectorfix[j].ceilingheight != DEFAULT)
-                    {
-                        char    *temp1 = commify(sectorfix[j].sector);
-                        char    *temp2 = commify(ss->ceilingheight);
-                        char    *temp3 = commify(sectorfix[j].ceilingheight);
+                if (sectorfix[j].ceilingheight != DEFAULT)
+                {
+                    char    *temp1 = commify(sectorfix[j].sector);
+                    char    *temp2 = commify(ss->ceilingheight);
+                    char    *temp3 = commify(sectorfix[j].ceilingheight);
 
-                        C_Warning(2, "The ceiling height of sector %s has been changed from %s to %s.", temp1, temp2, temp3);
+                    C_Warning(2, "The ceiling height of sector %s has been changed from %s to %s.", temp1, temp2, temp3);
 
-                        ss->ceilingheight = sectorfix[j].ceilingheight << FRACBITS;
-                        free(temp1);
-                        free(temp2);
-                        free(temp3);
-                    }
+                    ss->ceilingheight = sectorfix[j].ceilingheight << FRACBITS;
+                    free(temp1);
+                    free(temp2);
+                    free(temp3);
+                }
 
-                    if (sectorfix[j].special != DEFAULT)
-                    {
-                        char    *temp = commify(sectorfix[j].sector);
+                if (sectorfix[j].special != DEFAULT)
+                {
+                    char    *temp = commify(sectorfix[j].sector);
 
-                        if (ss->special)
-                            C_Warning(2, "The special of sector %s has been changed from %i (\"%s\") to %i (\"%s\").",
-                                temp, ss->special, sectorspecials[ss->special],
-                                sectorfix[j].special, sectorspecials[sectorfix[j].special]);
-                        else
-                            C_Warning(2, "A special of %i (\"%s\") has been added to sector %s.",
-                                sectorfix[j].special, sectorspecials[sectorfix[j].special], temp);
+                    if (ss->special)
+                        C_Warning(2, "The special of sector %s has been changed from %i (\"%s\") to %i (\"%s\").",
+                            temp, ss->special, sectorspecials[ss->special],
+                            sectorfix[j].special, sectorspecials[sectorfix[j].special]);
+                    else
+                        C_Warning(2, "A special of %i (\"%s\") has been added to sector %s.",
+                            sectorfix[j].special, sectorspecials[sectorfix[j].special], temp);
 
-                        ss->special = sectorfix[j].special;
-                        free(temp);
-                    }
+                    ss->special = sectorfix[j].special;
+                    free(temp);
+                }
 
-                    if (sectorfix[j].tag != DEFAULT)
-                    {
-                        char    *temp1 = commify(sectorfix[j].sector);
-                        char    *temp2 = commify(ss->tag);
-                        char    *temp3 = commify(sectorfix[j].tag);
+                if (sectorfix[j].tag != DEFAULT)
+                {
+                    char    *temp1 = commify(sectorfix[j].sector);
+                    char    *temp2 = commify(ss->tag);
+                    char    *temp3 = commify(sectorfix[j].tag);
 
-                        C_Warning(2, "The tag of sector %s has been changed from %s to %s.", temp1, temp2, temp3);
+                    C_Warning(2, "The tag of sector %s has been changed from %s to %s.", temp1, temp2, temp3);
 
-                        ss->tag = sectorfix[j].tag;
-                        free(temp1);
-                        free(temp2);
-                        free(temp3);
-                    }
-
-                    break;
+                    ss->tag = sectorfix[j].tag;
+                    free(temp1);
+                    free(temp2);
+                    free(temp3);
                 }
 
+                break;
+            }
+
         // [AM] Sector interpolation. Even if we're
         //      not running uncapped, the renderer still
         //      uses this data.
@@ -1760,10 +1756,8 @@ static void P_LoadThings(int map, int lump)
 
         // [BH] Apply any level-specific fixes.
         if (canmodify && r_fixmaperrors)
-            for (int j = 0; thingfix[j].mission != -1; j++)
-                if (gamemission == thingfix[j].mission && gameepisode == thingfix[j].episode && gamemap == thingfix[j].map
-                    && gamemode != shareware && thingid == thingfix[j].thing && mt.type == thingfix[j].type
-                    && mt.x == thingfix[j].oldx && mt.y == thingfix[j].oldy)
+            for (int j = P_FirstFix(&thingfixes, thingid); j >= 0; j = P_NextFix(&thingfixes, j))
+                if (mt.type == thingfix[j].type && mt.x == thingfix[j].oldx && mt.y == thingfix[j].oldy)
                 {
                     char    *temp = commify(thingid);
 
@@ -2051,10 +2045,10 @@ static void P_LoadSideDefs2(int lump)
 //
 // haleyjd 03/04/10: do verification on validity of blockmap.
 //
-static dboolean P_VerifyBlockMap(int count)
+static dboolean P_VerifyBlockMap(const int *blockmaplump, int count)
 {
     dboolean    isvalid = true;
-    int         *maxoffs = blockmaplump + count;
+    const int   *maxoffs = blockmaplump + count;
 
     skipblstart = true;
 
@@ -2062,9 +2056,9 @@ static dboolean P_VerifyBlockMap(int count)
     {
         for (int x = 0; x < bmapwidth; x++)
         {
-            int offset = y * bmapwidth + x;
-            int *list;
-            int *blockoffset = blockmaplump + offset + 4;
+            int         offset = y * bmapwidth + x;
+            const int   *list;
+            const int   *blockoffset = blockmaplump + offset + 4;
 
             // check that block offset is in bounds
             if (blockoffset >= maxoffs)
@@ -2080,7 +2074,7 @@ static dboolean P_VerifyBlockMap(int count)
                 skipblstart = false;
 
             // scan forward for a -1 terminator before maxoffs
-            for (int *tmplist = list; ; tmplist++)
+            for (const int *tmplist = list; ; tmplist++)
             {
                 // we have overflowed the lump?
                 if (tmplist >= maxoffs)
@@ -2097,7 +2091,7 @@ static dboolean P_VerifyBlockMap(int count)
                 break;
 
             // scan the list for out-of-range linedef indicies in list
-            for (int *tmplist = list; *tmplist != -1; tmplist++)
+            for (const int *tmplist = list; *tmplist != -1; tmplist++)
                 if (*tmplist < 0 || *tmplist >= numlines)
                 {
                     isvalid = false;
@@ -2116,6 +2110,111 @@ static dboolean P_VerifyBlockMap(int count)
     return isvalid;
 }
 
+//
+// P_SetBlockLines
+//
+// Repacks the offsets and -1 terminated linedef lists of a verified BLOCKMAP
+// lump into one contiguous array of line pointers, with blockmap[] holding
+// the start of each block's list and blockmap[bmapwidth * bmapheight] the end
+// of the last one.
+//
+static void P_SetBlockLines(const int *blockmaplump)
+{
+    const int   tot = bmapwidth * bmapheight;
+    int         count = 0;
+
+    blockmap = malloc(((size_t)tot + 1) * sizeof(*blockmap));
+
+    for (int i = 0; i < tot; i++)
+    {
+        const int   *list = blockmaplump + blockmaplump[i + 4] + skipblstart;
+
+        blockmap[i] = count;
+
+        while (*list++ != -1)
+            count++;
+    }
+
+    blockmap[tot] = count;
+    blocklines = malloc(MAX(1, count) * sizeof(*blocklines));
+
+    for (int i = 0; i < tot; i++)
+    {
+        line_t  **block = blocklines + blockmap[i];
+
+        for (const int *list = blockmaplump + blockmaplump[i + 4] + skipblstart; *list != -1; list++)
+            *block++ = lines + *list;
+    }
+}
+
+//
+// P_GetLineBlocks
+//
+// Uses a Bresenham-like algorithm on a linedef to find each block visited
+// from the beginning to the end of it. Returns the number of blocks stored in
+// blocks[], which must have room for bmapwidth + bmapheight entries.
+//
+static int P_GetLineBlocks(const line_t *line, int minx, int miny, int *blocks)
+{
+    const unsigned int  tot = bmapwidth * bmapheight;
+    int                 numblocks = 0;
+
+    // starting coordinates
+    int x = (line->v1->x >> FRACBITS) - minx;
+    int y = (line->v1->y >> FRACBITS) - miny;
+
+    // x - y deltas
+    int adx = line->dx >> FRACBITS;
+    int dx = SIGN(adx);
+    int ady = line->dy >> FRACBITS;
+    int dy = SIGN(ady);
+
+    // difference in preferring to move across y (> 0) instead of x (< 0)
+    int diff = (!adx ? 1 : (!ady ? -1 : (((x >> MAPBTOFRAC) << MAPBTOFRAC)
+            + (dx > 0 ? MAPBLOCKUNITS - 1 : 0) - x) * (ady = ABS(ady)) * dx
+            - (((y >> MAPBTOFRAC) << MAPBTOFRAC) + (dy > 0 ? MAPBLOCKUNITS - 1 : 0) - y)
+            * (adx = ABS(adx)) * dy));
+
+    // starting block
+    int b = (y >> MAPBTOFRAC) * bmapwidth + (x >> MAPBTOFRAC);
+
+    // ending block
+    int bend = (((line->v2->y >> FRACBITS) - miny) >> MAPBTOFRAC) * bmapwidth
+            + (((line->v2->x >> FRACBITS) - minx) >> MAPBTOFRAC);
+
+    // delta for block when moving across y
+    dy *= bmapwidth;
+
+    // deltas for diff inside the loop
+    adx <<= MAPBTOFRAC;
+    ady <<= MAPBTOFRAC;
+
+    // Now we simply iterate block-by-block until we reach the end block.
+    while ((unsigned int)b < tot)   // failsafe -- should ALWAYS be true
+    {
+        blocks[numblocks++] = b;
+
+        // If we have reached the last block, or somehow gone further than any
+        // straight line could, exit
+        if (b == bend || numblocks == bmapwidth + bmapheight)
+            break;
+
+        // Move in either the x or y direction to the next block
+        if (diff < 0)
+        {
+            diff += ady;
+            b += dx;
+        }
+        else
+        {
+            diff -= adx;
+            b += dy;
+        }
+    }
+
+    return numblocks;
+}
+
 //
 // killough 10/98:
 //
@@ -2129,13 +2228,18 @@ static dboolean P_VerifyBlockMap(int count)
 // Please note: This section of code is not interchangeable with TeamTNT's
 // code which attempts to fix the same problem.
 //
+// [BH] The blocks visited by each linedef are first counted so the linedef
+// lists can be built directly into one contiguous array, rather than growing
+// a separate list for each block and then compressing them into a lump.
+//
 static void P_CreateBlockMap(void)
 {
-    int     i;
     fixed_t minx = FIXED_MAX;
     fixed_t miny = FIXED_MAX;
     fixed_t maxx = FIXED_MIN;
     fixed_t maxy = FIXED_MIN;
+    int     tot;
+    int     *blocks;
 
     // This fixes MBF's code, which has a bug where maxx/maxy
     // are wrong if the 0th node has the largest x or y
@@ -2147,7 +2251,7 @@ static void P_CreateBlockMap(void)
 
     blockmaprebuilt = true;
 
-    for (i = 0; i < numvertexes; i++)
+    for (int i = 0; i < numvertexes; i++)
     {
         if ((vertexes[i].x >> FRACBITS) < minx)
             minx = vertexes[i].x >> FRACBITS;
@@ -2172,142 +2276,29 @@ static void P_CreateBlockMap(void)
     bmapwidth = ((maxx - minx) >> MAPBTOFRAC) + 1;
     bmapheight = ((maxy - miny) >> MAPBTOFRAC) + 1;
 
-    // Compute blockmap, which is stored as a 2d array of variable-sized lists.
-    //
-    // Pseudocode:
-    //
-    // For each linedef:
-    //
-    //   Map the starting and ending vertexes to blocks.
-    //
-    //   Starting in the starting vertex's block, do:
-    //
-    //     Add linedef to current block's list, dynamically resizing it.
-    //
-    //     If current block is the same as the ending vertex's block, exit loop.
-    //
-    //     Move to an adjacent block by moving towards the ending block in
-    //     either the x or y direction, to the block which contains the linedef.
-    {
-        // blocklist structure
-        typedef struct
-        {
-            int n;
-            int nalloc;
-            int *list;
-        } bmap_t;
+    tot = bmapwidth * bmapheight;
+    blocks = malloc(((size_t)bmapwidth + bmapheight) * sizeof(*blocks));
+    blockmap = calloc((size_t)tot + 1, sizeof(*blockmap));
 
-        unsigned int    tot = bmapwidth * bmapheight;           // size of blockmap
-        bmap_t          *bmap = calloc(tot, sizeof(*bmap));     // array of blocklists
-
-        for (i = 0; i < numlines; i++)
-        {
-            // starting coordinates
-            int x = (lines[i].v1->x >> FRACBITS) - minx;
-            int y = (lines[i].v1->y >> FRACBITS) - miny;
-
-            // x - y deltas
-            int adx = lines[i].dx >> FRACBITS;
-            int dx = SIGN(adx);
-            int ady = lines[i].dy >> FRACBITS;
-            int dy = SIGN(ady);
-
-            // difference in preferring to move across y (> 0) instead of x (< 0)
-            int diff = (!adx ? 1 : (!ady ? -1 : (((x >> MAPBTOFRAC) << MAPBTOFRAC)
-                    + (dx > 0 ? MAPBLOCKUNITS - 1 : 0) - x) * (ady = ABS(ady)) * dx
-                    - (((y >> MAPBTOFRAC) << MAPBTOFRAC) + (dy > 0 ? MAPBLOCKUNITS - 1 : 0) - y)
-                    * (adx = ABS(adx)) * dy));
-
-            // starting block, and pointer to its blocklist structure
-            int b = (y >> MAPBTOFRAC) * bmapwidth + (x >> MAPBTOFRAC);
-
-            // ending block
-            int bend = (((lines[i].v2->y >> FRACBITS) - miny) >> MAPBTOFRAC) * bmapwidth
-                    + (((lines[i].v2->x >> FRACBITS) - minx) >> MAPBTOFRAC);
-
-            // delta for pointer when moving across y
-            dy *= bmapwidth;
-
-            // deltas for diff inside the loop
-            adx <<= MAPBTOFRAC;
-            ady <<= MAPBTOFRAC;
-
-            // Now we simply iterate block-by-block until we reach the end block.
-            while ((unsigned int)b < tot)       // failsafe -- should ALWAYS be true
-            {
-                bmap_t  *bp = &bmap[b];
-
-                // Increase size of allocated list if necessary
-                if (bp->n >= bp->nalloc)
-                    bp->list = I_Realloc(bp->list, (bp->nalloc = (bp->nalloc ? bp->nalloc * 2 : 8)) * sizeof(*bp->list));
-
-                // Add linedef to end of list
-                bp->list[bp->n++] = i;
-
-                // If we have reached the last block, exit
-                if (b == bend)
-                    break;
-
-                // Move in either the x or y direction to the next block
-                if (diff < 0)
-                {
-                    diff += ady;
-                    b += dx;
-                }
-                else
-                {
-                    diff -= adx;
-                    b += dy;
-                }
-            }
-        }
-
-        // Compute the total size of the blockmap.
-        //
-        // Compression of empty blocks is performed by reserving two offset words
-        // at tot and tot + 1.
-        //
-        // 4 words, unused if this routine is called, are reserved at the start.
-        {
-            int count = tot + 6;                // we need at least 1 word per block, plus reserved's
-
-            for (i = 0; (unsigned int)i < tot; i++)
-                if (bmap[i].n)
-                    count += bmap[i].n + 2;     // 1 header word + 1 trailer word + blocklist
-
-            // Allocate blockmap lump with computed count
-            blockmaplump = malloc_IfSameLevel(blockmaplump, sizeof(*blockmaplump) * count);
-        }
-
-        // Now compress the blockmap.
-        {
-            int     ndx = (tot += 4);           // Advance index to start of linedef lists
-            bmap_t  *bp = bmap;                 // Start of uncompressed blockmap
-
-            blockmaplump[ndx++] = 0;            // Store an empty blockmap list at start
-            blockmaplump[ndx++] = -1;           // (Used for compression)
-
-            for (i = 4; (unsigned int)i < tot; i++, bp++)
-                if (bp->n)                                              // Non-empty blocklist
-                {
-                    blockmaplump[(blockmaplump[i] = ndx++)] = 0;        // Store index & header
+    // Count the linedefs in each block
+    for (int i = 0; i < numlines; i++)
+        for (int j = 0, numblocks = P_GetLineBlocks(&lines[i], minx, miny, blocks); j < numblocks; j++)
+            blockmap[blocks[j]]++;
 
-                    do
-                        blockmaplump[ndx++] = bp->list[--bp->n];        // Copy linedef list
-                    while (bp->n);
+    // Turn the counts into the end of each block's list
+    for (int i = 1; i <= tot; i++)
+        blockmap[i] += blockmap[i - 1];
 
-                    blockmaplump[ndx++] = -1;                           // Store trailer
-                    free(bp->list);                                     // Free linedef list
-                }
-                else
-                    // Empty blocklist: point to reserved empty blocklist
-                    blockmaplump[i] = tot;
+    blocklines = malloc(MAX(1, blockmap[tot]) * sizeof(*blocklines));
 
-            free(bmap);                         // Free uncompressed blockmap
-        }
-    }
+    // Fill each block's list from its end, leaving blockmap[] pointing at the
+    // start of each list. Linedefs end up in descending order, the same order
+    // the original algorithm stored them in.
+    for (int i = 0; i < numlines; i++)
+        for (int j = 0, numblocks = P_GetLineBlocks(&lines[i], minx, miny, blocks); j < numblocks; j++)
+            blocklines[--blockmap[blocks[j]]] = &lines[i];
 
-    skipblstart = true;
+    free(blocks);
 }
 
 //
@@ -2339,8 +2330,7 @@ static void P_LoadBlockMap(int lump)
     else
     {
         short   *wadblockmaplump = W_CacheLumpNum(lump);
-
-        blockmaplump = malloc_IfSameLevel(blockmaplump, sizeof(*blockmaplump) * count);
+        int     *blockmaplump = malloc(sizeof(*blockmaplump) * count);
 
         // killough 03/01/98: Expand wad blockmap into larger internal one,
         // by treating all offsets except -1 as unsigned and zero-extending
@@ -2359,22 +2349,27 @@ static void P_LoadBlockMap(int lump)
             blockmaplump[i] = (t == -1 ? -1L : ((unsigned int)t & 0xFFFF));
         }
 
+        W_ReleaseLumpNum(lump);
+
         // Read the header
         bmaporgx = blockmaplump[0] << FRACBITS;
         bmaporgy = blockmaplump[1] << FRACBITS;
         bmapwidth = blockmaplump[2];
         bmapheight = blockmaplump[3];
 
-        if (!P_VerifyBlockMap(count))
+        if (P_VerifyBlockMap(blockmaplump, count))
+            P_SetBlockLines(blockmaplump);
+        else
         {
             P_CreateBlockMap();
             C_Warning(2, "The " BOLD("BLOCKMAP") " lump has been rebuilt.");
         }
+
+        free(blockmaplump);
     }
 
-    // Clear out mobj chains
-    blocklinks = calloc_IfSameLevel(blocklinks, (size_t)bmapwidth * bmapheight, sizeof(*blocklinks));
-    blockmap = blockmaplump + 4;
+    // Clear out mobj lists
+    blockthings = calloc((size_t)bmapwidth * bmapheight, sizeof(*blockthings));
 
     // MAES: set blockmapxneg and blockmapyneg
     // E.g. for a full 512x512 map, they should be both
@@ -2826,6 +2821,45 @@ static mapformat_t P_CheckMapFormat(int lumpnum)
     return format;
 }
 
+static int  prefetchlump = -1;
+static int  prefetchend;
+
+//
+// P_PrefetchLevel
+// Called when the intermission starts with the map that will be loaded
+// next. Its lumps are then cached a tic at a time by P_PrefetchLevelLump()
+// while the intermission is shown, so P_SetupLevel() finds them resident
+// rather than reading them all from disk at once.
+//
+void P_PrefetchLevel(int ep, int map)
+{
+    char    lumpname[6];
+    int     lumpnum;
+
+    if (gamemode == commercial)
+        M_snprintf(lumpname, sizeof(lumpname), "MAP%02i", map);
+    else
+        M_snprintf(lumpname, sizeof(lumpname), "E%iM%i", ep, map);
+
+    if ((lumpnum = W_CheckNumForName(lumpname)) < 0)
+    {
+        prefetchlump = -1;
+        return;
+    }
+
+    if (nerve && gamemission == doom2)
+        lumpnum = W_GetLastNumForName(lumpname);
+
+    prefetchlump = lumpnum + ML_THINGS;
+    prefetchend = MIN(lumpnum + ML_BLOCKMAP, numlumps - 1);
+}
+
+void P_PrefetchLevelLump(void)
+{
+    if (prefetchlump >= 0 && prefetchlump <= prefetchend)
+        W_PrefetchLumpNum(prefetchlump++);
+}
+
 //
 // P_SetupLevel
 //
@@ -2933,8 +2967,9 @@ void P_SetupLevel(int ep, int map)
         free(segs);
         free(nodes);
         free(subsectors);
-        free(blocklinks);
-        free(blockmaplump);
+        P_FreeBlockThings();
+        free(blockmap);
+        free(blocklines);
         free(lines);
         free(sides);
         free(sectors);
@@ -2956,7 +2991,7 @@ void P_SetupLevel(int ep, int map)
     if (!samelevel)
         P_LoadBlockMap(lumpnum + ML_BLOCKMAP);
     else
-        memset(blocklinks, 0, (size_t)bmapwidth * bmapheight * sizeof(*blocklinks));
+        P_ClearBlockThings();
 
     if (mapformat == ZDBSPX)
         P_LoadZNodes(lumpnum + ML_NODES);
@@ -3610,6 +3645,7 @@ int P_GetMapTitlePatch(int map)
 //
 void P_Init(void)
 {
+    P_InitFixes();
     P_InitSwitchList();
     P_InitPicAnims();
     P_InitMapInfo();
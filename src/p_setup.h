@@ -41,7 +41,6 @@
 
 extern dboolean     canmodify;
 extern dboolean     samelevel;
-extern dboolean     skipblstart;    // MaxW: Skip initial blocklist short
 extern const char   *linespecials[];
 
 extern char         mapnum[6];
@@ -50,6 +49,8 @@ extern char         mapnumandtitle[512];
 extern char         automaptitle[512];
 
 void P_SetupLevel(int ep, int map);
+void P_PrefetchLevel(int ep, int map);
+void P_PrefetchLevelLump(void);
 void P_MapName(int ep, int map);
 
 // Called by startup code.
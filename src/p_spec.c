@@ -130,6 +130,7 @@ dboolean        *isteleport;
 static void P_SpawnScrollers(void);
 static void P_SpawnFriction(void);  // phares 03/16/98
 static void P_SpawnPushers(void);   // phares 03/20/98
+static void P_ApplySectorForces(void);
 
 extern int  numflats;
 
@@ -2300,6 +2301,9 @@ int countdown;
 
 void P_UpdateSpecials(void)
 {
+    // apply the forces summed by this tic's scrollers and pushers
+    P_ApplySectorForces();
+
     // ANIMATE FLATS AND TEXTURES GLOBALLY
     for (anim_t *anim = anims; anim < lastanim; anim++)
         if (!(gametime & (anim->speed - 1)))
@@ -2626,6 +2630,42 @@ void P_SpawnSpecials(void)
         }
 }
 
+//
+// Carrying scrollers and wind/current pushers only sum their forces
+// into the sector they affect. The sector's things are then looped through
+// once per tic, rather than once for each scroller and pusher, by
+// P_ApplySectorForces(). As the forces only change the things' momentum,
+// which isn't used until the things next think, the result is the same.
+//
+static sector_t **forcedsectors;
+static int      numforcedsectors;
+static int      maxforcedsectors;
+
+static sector_t *P_ForceSector(sector_t *sec)
+{
+    if (!sec->forced)
+    {
+        if (numforcedsectors == maxforcedsectors)
+        {
+            maxforcedsectors = (maxforcedsectors ? maxforcedsectors * 2 : 64);
+            forcedsectors = I_Realloc(forcedsectors, maxforcedsectors * sizeof(*forcedsectors));
+        }
+
+        forcedsectors[numforcedsectors++] = sec;
+        sec->forced = true;
+        sec->carryx = 0;
+        sec->carryy = 0;
+        sec->windx = 0;
+        sec->windy = 0;
+        sec->halfwindx = 0;
+        sec->halfwindy = 0;
+        sec->currentx = 0;
+        sec->currenty = 0;
+    }
+
+    return sec;
+}
+
 // killough 02/28/98:
 //
 // This function, with the help of r_plane.c and r_bsp.c, supports generalized
@@ -2711,34 +2751,14 @@ void T_Scroll(scroll_t *s)
 
             break;
 
-        case sc_carry:
-        {
-            fixed_t height;
-            fixed_t waterheight;                // killough 04/04/98: add waterheight
-
-            // killough 03/07/98: Carry things on floor
-            // killough 03/20/98: use new sector list which reflects true members
-            // killough 03/27/98: fix carrier bug
-            // killough 04/04/98: Underwater, carry things even w/o gravity
-            sec = sectors + s->affectee;
-            height = sec->floorheight;
-            waterheight = (sec->heightsec && sec->heightsec->floorheight > height ? sec->heightsec->floorheight : FIXED_MIN);
-
-            // Move objects only if on floor or underwater,
-            // non-floating, and clipped.
-            for (msecnode_t *node = sec->touching_thinglist; node; node = node->m_snext)
-            {
-                mobj_t  *thing = node->m_thing;
-
-                if (!(thing->flags & MF_NOCLIP) && (!((thing->flags & MF_NOGRAVITY) || thing->z > height) || thing->z < waterheight))
-                {
-                    thing->momx += dx;
-                    thing->momy += dy;
-                }
-            }
+        case sc_carry:                          // killough 03/07/98: Carry things on floor
+            // things are carried by P_ApplySectorForces() once all
+            // scrollers and pushers have run
+            sec = P_ForceSector(sectors + s->affectee);
+            sec->carryx += dx;
+            sec->carryy += dy;
 
             break;
-        }
     }
 }
 
@@ -3120,11 +3140,7 @@ static dboolean PIT_PushThing(mobj_t *thing)
 //
 void T_Pusher(pusher_t *p)
 {
-    sector_t    *sec;
-    int         xspeed, yspeed;
-    int         ht = 0;
-
-    sec = sectors + p->affectee;
+    sector_t    *sec = sectors + p->affectee;
 
     // Be sure the special sector type is still turned on. If so, proceed.
     // Else, bail out; the sector type has been changed on us.
@@ -3161,97 +3177,117 @@ void T_Pusher(pusher_t *p)
         tmbbox[BOXRIGHT] = p->x + radius;
         tmbbox[BOXLEFT] = p->x - radius;
 
-        xl = P_GetSafeBlockX(tmbbox[BOXLEFT] - bmaporgx - MAXRADIUS);
-        xh = P_GetSafeBlockX(tmbbox[BOXRIGHT] - bmaporgx + MAXRADIUS);
-        yl = P_GetSafeBlockY(tmbbox[BOXBOTTOM] - bmaporgy - MAXRADIUS);
-        yh = P_GetSafeBlockY(tmbbox[BOXTOP] - bmaporgy + MAXRADIUS);
+        xl = P_GetSafeBlockX(tmbbox[BOXLEFT] - bmaporgx);
+        xh = P_GetSafeBlockX(tmbbox[BOXRIGHT] - bmaporgx);
+        yl = P_GetSafeBlockY(tmbbox[BOXBOTTOM] - bmaporgy);
+        yh = P_GetSafeBlockY(tmbbox[BOXTOP] - bmaporgy);
 
-        for (int bx = xl; bx <= xh; bx++)
-            for (int by = yl; by <= yh; by++)
-                P_BlockThingsIterator(bx, by, &PIT_PushThing);
+        P_BlockThingsIterator(xl, yl, xh, yh, &PIT_PushThing);
 
         return;
     }
 
     // constant pushers p_wind and p_current
-    if (sec->heightsec)                           // special water sector?
-        ht = sec->heightsec->floorheight;
+    // things touching this sector are pushed by P_ApplySectorForces()
+    // once all scrollers and pushers have run
+    P_ForceSector(sec);
 
-    // things touching this sector
-    for (msecnode_t *node = sec->touching_thinglist; node; node = node->m_snext)
+    if (p->type == p_wind)
     {
-        mobj_t  *thing = node->m_thing;
+        sec->windx += p->x_mag;
+        sec->windy += p->y_mag;
+        sec->halfwindx += p->x_mag >> 1;
+        sec->halfwindy += p->y_mag >> 1;
+    }
+    else
+    {
+        sec->currentx += p->x_mag;
+        sec->currenty += p->y_mag;
+    }
+}
 
-        if (!thing->player || (thing->flags & (MF_NOGRAVITY | MF_NOCLIP)))
-            continue;
+static void P_ApplySectorForces(void)
+{
+    for (int i = 0; i < numforcedsectors; i++)
+    {
+        sector_t    *sec = forcedsectors[i];
+        fixed_t     height = sec->floorheight;
+        fixed_t     ht = (sec->heightsec ? sec->heightsec->floorheight : 0);
+        fixed_t     waterheight = (sec->heightsec && ht > height ? ht : FIXED_MIN); // killough 04/04/98: add waterheight
+        dboolean    carry = (sec->carryx | sec->carryy);
+        dboolean    push = (sec->windx | sec->windy | sec->halfwindx | sec->halfwindy | sec->currentx | sec->currenty);
 
-        if (p->type == p_wind)
+        sec->forced = false;
+
+        // killough 03/20/98: use new sector list which reflects true members
+        for (msecnode_t *node = sec->touching_thinglist; node; node = node->m_snext)
         {
-            if (!sec->heightsec)                        // NOT special water sector
+            mobj_t  *thing = node->m_thing;
+            int     flags = thing->flags;
+
+            // killough 03/07/98: Carry things on floor
+            // killough 03/27/98: fix carrier bug
+            // killough 04/04/98: Underwater, carry things even w/o gravity
+            // Move objects only if on floor or underwater,
+            // non-floating, and clipped.
+            if (carry && !(flags & MF_NOCLIP) && (!((flags & MF_NOGRAVITY) || thing->z > height) || thing->z < waterheight))
             {
-                if (thing->z > thing->floorz)           // above ground
-                {
-                    xspeed = p->x_mag;                  // full force
-                    yspeed = p->y_mag;
-                }
-                else                                    // on ground
-                {
-                    xspeed = p->x_mag >> 1;             // half force
-                    yspeed = p->y_mag >> 1;
-                }
+                thing->momx += sec->carryx;
+                thing->momy += sec->carryy;
             }
-            else                                        // special water sector
+
+            // phares 03/20/98: constant pushers p_wind and p_current
+            if (push && thing->player && !(flags & (MF_NOGRAVITY | MF_NOCLIP)))
             {
-                if (thing->z > ht)                      // above ground
-                {
-                    xspeed = p->x_mag;                  // full force
-                    yspeed = p->y_mag;
-                }
-                else
+                int xspeed = 0;
+                int yspeed = 0;
+
+                if (!sec->heightsec)                    // NOT special water sector
                 {
-                    if (thing->player->viewz < ht)      // underwater
-                        xspeed = yspeed = 0;            // no force
-                    else                                // wading in water
+                    if (thing->z > thing->floorz)       // above ground
                     {
-                        xspeed = p->x_mag >> 1;         // half force
-                        yspeed = p->y_mag >> 1;
+                        xspeed += sec->windx;           // full force of wind
+                        yspeed += sec->windy;
+                    }
+                    else                                // on ground
+                    {
+                        xspeed += sec->halfwindx;       // half force of wind
+                        yspeed += sec->halfwindy;
+                    }
+
+                    if (thing->z <= height)             // on ground
+                    {
+                        xspeed += sec->currentx;        // full force of current
+                        yspeed += sec->currenty;
                     }
                 }
-            }
-        }
-        else                                            // p_current
-        {
-            if (!sec->heightsec)                        // NOT special water sector
-            {
-                if (thing->z > sec->floorheight)        // above ground
-                {
-                    xspeed = 0;                         // no force
-                    yspeed = 0;
-                }
-                else                                    // on ground
-                {
-                    xspeed = p->x_mag;                  // full force
-                    yspeed = p->y_mag;
-                }
-            }
-            else                                        // special water sector
-            {
-                if (thing->z > ht)                      // above ground
-                {
-                    xspeed = 0;                         // no force
-                    yspeed = 0;
-                }
-                else                                    // underwater
+                else                                    // special water sector
                 {
-                    xspeed = p->x_mag;                  // full force
-                    yspeed = p->y_mag;
+                    if (thing->z > ht)                  // above ground
+                    {
+                        xspeed += sec->windx;           // full force of wind
+                        yspeed += sec->windy;
+                    }
+                    else
+                    {
+                        if (thing->player->viewz >= ht) // wading in water
+                        {
+                            xspeed += sec->halfwindx;   // half force of wind
+                            yspeed += sec->halfwindy;
+                        }
+
+                        xspeed += sec->currentx;        // full force of current
+                        yspeed += sec->currenty;
+                    }
                 }
+
+                thing->momx += xspeed << (FRACBITS - PUSH_FACTOR);
+                thing->momy += yspeed << (FRACBITS - PUSH_FACTOR);
             }
         }
-
-        thing->momx += xspeed << (FRACBITS - PUSH_FACTOR);
-        thing->momy += yspeed << (FRACBITS - PUSH_FACTOR);
     }
+
+    numforcedsectors = 0;
 }
 
 // P_GetPushThing() returns a pointer to an MT_PUSH or MT_PULL thing, NULL otherwise.
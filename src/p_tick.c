@@ -64,11 +64,40 @@ thinker_t       thinkers[th_all + 1];
 //
 void P_InitThinkers(void)
 {
-    thinkers[th_mobj].cprev = thinkers[th_mobj].cnext = &thinkers[th_mobj];
-    thinkers[th_misc].cprev = thinkers[th_misc].cnext = &thinkers[th_misc];
+    for (int i = 0; i < NUMTHCLASS; i++)
+        thinkers[i].cprev = thinkers[i].cnext = &thinkers[i];
+
     thinkers[th_all].prev = thinkers[th_all].next = &thinkers[th_all];
 }
 
+//
+// P_ThinkerClass
+// Thinkers whose function changes while they are active,
+// such as plats going into stasis, stay in the same class.
+//
+static int P_ThinkerClass(think_t function)
+{
+    if (function == &P_MobjThinker)
+        return th_mobj;
+    else if (function == &T_MoveFloor || function == &T_MoveElevator)
+        return th_floor;
+    else if (function == &T_MoveCeiling || function == &T_CeilingStay)
+        return th_ceiling;
+    else if (function == &T_VerticalDoor)
+        return th_door;
+    else if (function == &T_PlatRaise || function == &T_PlatStay)
+        return th_plat;
+    else if (function == &T_LightFlash || function == &T_StrobeFlash
+        || function == &T_Glow || function == &T_FireFlicker)
+        return th_light;
+    else if (function == &T_Scroll)
+        return th_scroll;
+    else if (function == &T_Pusher)
+        return th_pusher;
+    else
+        return th_misc;
+}
+
 //
 // P_UpdateThinker
 //
@@ -81,7 +110,7 @@ void P_UpdateThinker(thinker_t *thinker)
         (th->cprev = thinker->cprev)->cnext = th;
 
     // Add to appropriate thread
-    th = &thinkers[(thinker->function == &P_MobjThinker ? th_mobj : th_misc)];
+    th = &thinkers[P_ThinkerClass(thinker->function)];
     th->cprev->cnext = thinker;
     thinker->cnext = th;
     thinker->cprev = th->cprev;
@@ -195,9 +224,10 @@ void P_Ticker(void)
 
     if (menuactive && !freeze)
     {
-        for (currentthinker = thinkers[th_misc].cnext; currentthinker != &thinkers[th_misc]; currentthinker = currentthinker->cnext)
-            if (currentthinker->menu)
-                currentthinker->function((mobj_t *)currentthinker);
+        for (int i = th_mobj + 1; i < NUMTHCLASS; i++)
+            for (currentthinker = thinkers[i].cnext; currentthinker != &thinkers[i]; currentthinker = currentthinker->cnext)
+                if (currentthinker->menu)
+                    currentthinker->function((mobj_t *)currentthinker);
 
         P_UpdateSpecials();
         return;
@@ -211,11 +241,17 @@ void P_Ticker(void)
         return;
     }
 
+    // run each class of thinker in turn, calling P_MobjThinker() directly
+    // unless a mobj is pending deletion
     for (currentthinker = thinkers[th_mobj].cnext; currentthinker != &thinkers[th_mobj]; currentthinker = currentthinker->cnext)
-        currentthinker->function((mobj_t *)currentthinker);
-
-    for (currentthinker = thinkers[th_misc].cnext; currentthinker != &thinkers[th_misc]; currentthinker = currentthinker->cnext)
-        currentthinker->function((mobj_t *)currentthinker);
+        if (currentthinker->function == &P_MobjThinker)
+            P_MobjThinker((mobj_t *)currentthinker);
+        else
+            currentthinker->function((mobj_t *)currentthinker);
+
+    for (int i = th_mobj + 1; i < NUMTHCLASS; i++)
+        for (currentthinker = thinkers[i].cnext; currentthinker != &thinkers[i]; currentthinker = currentthinker->cnext)
+            currentthinker->function((mobj_t *)currentthinker);
 
     P_UpdateSpecials();
 
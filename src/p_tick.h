@@ -57,10 +57,19 @@ void P_SetTarget(mobj_t **mop, mobj_t *targ);           // killough 11/98
 // killough 08/29/98: threads of thinkers, for more efficient searches
 // cph 01/13/02: for consistency with the main thinker list, keep objects
 // pending deletion on a class list too
+// [BH] specials are also split into classes, so P_Ticker() can run each
+// kind of thinker together
 enum
 {
     th_mobj,
-    th_misc,
+    th_floor,       // T_MoveFloor() and T_MoveElevator()
+    th_ceiling,     // T_MoveCeiling() and T_CeilingStay()
+    th_door,        // T_VerticalDoor()
+    th_plat,        // T_PlatRaise() and T_PlatStay()
+    th_light,       // T_LightFlash(), T_StrobeFlash(), T_Glow() and T_FireFlicker()
+    th_scroll,      // T_Scroll()
+    th_pusher,      // T_Pusher()
+    th_misc,        // anything else
     NUMTHCLASS,
     th_all = NUMTHCLASS
 };
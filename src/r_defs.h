@@ -192,6 +192,14 @@ typedef struct sector_s
     int                 friction;
     int                 movefactor;
 
+    // forces from carrying scrollers and wind/current pushers, summed
+    // each tic and then applied in one pass over the sector's things
+    dboolean            forced;
+    fixed_t             carryx, carryy;
+    int                 windx, windy;
+    int                 halfwindx, halfwindy;
+    int                 currentx, currenty;
+
     // killough 10/98: support skies coming from sidedefs. Allows scrolling
     // skies and other effects. No "level info" kind of lump is needed,
     // because you can use an arbitrary number of skies per level with this
@@ -777,7 +777,6 @@ void R_Init(void)
     R_InitLightTables();
     R_InitTranslationTables();
     R_InitPatches();
-    R_InitDistortedFlats();
     R_InitColumnFunctions();
 }
 
@@ -82,6 +82,19 @@ typedef struct
 
     // handle of the sound being played
     int             handle;
+
+    // position of origin, and the volume and separation last used, so they're
+    // only recalculated and updated when something has changed
+    fixed_t         x, y;
+    int             volume;
+    int             sep;
+
+    // set if the last update couldn't be queued, so that it's tried again
+    dboolean        stale;
+
+    // position in the priority heap, and the next channel in the same origin hash chain
+    int             heapindex;
+    int             nextorigin;
 } channel_t;
 
 // [crispy] "sound objects" hold the coordinates of removed map objects
@@ -95,8 +108,22 @@ typedef struct
 static channel_t    *channels;
 static sobj_t       *sobjs;
 
+// Starting a sound doesn't check every channel. Free channels are a bitmask
+// (s_channels_max is 64). Busy channels are kept in a binary heap, with the
+// one playing the sound with the lowest priority (the highest priority value)
+// on top, and are hashed by their origin.
+#define ORIGINHASHSIZE  128
+
+static uint64_t     freechannels;
+static int          channelheap[s_channels_max];
+static int          numbusychannels;
+static int          originhash[ORIGINHASHSIZE];
+
+int                 s_cachesize = s_cachesize_default;
 int                 s_channels = s_channels_default;
 int                 s_musicvolume = s_musicvolume_default;
+dboolean            s_occlusion = s_occlusion_default;
+dboolean            s_oplmusic = s_oplmusic_default;
 dboolean            s_randommusic = s_randommusic_default;
 dboolean            s_randompitch = s_randompitch_default;
 int                 s_sfxvolume = s_sfxvolume_default;
@@ -123,6 +150,28 @@ dboolean            nomusic;
 
 musinfo_t           musinfo;
 
+//
+// Registered songs are kept in a small cache, keyed by lump number, so that
+// switching to music that's been played before, or that was loaded while
+// setting up the map, doesn't have to load and convert it again.
+//
+#define MUSICCACHESIZE      8
+
+typedef struct
+{
+    int             lumpnum;
+    void            *handle;
+    dboolean        midimusictype;
+    dboolean        musmusictype;
+    int             lastused;
+} cachedmusic_t;
+
+static cachedmusic_t    musiccache[MUSICCACHESIZE];
+static int              musiccachetime;
+
+// MUSINFO changes fade in the new music over this many milliseconds
+#define MUSINFOFADETIME     500
+
 #if defined(_WIN32)
 extern dboolean     serverMidiPlaying;
 #endif
@@ -182,12 +231,16 @@ void S_Init(void)
         }
     }
 
+    // -headless: use SDL's dummy audio driver, which still mixes but never opens a device
+    if (headless)
+        SDL_setenv("SDL_AUDIODRIVER", "dummy", true);
+
     if (!nosfx)
     {
 #if defined(_WIN32)
         char    *audiodriver = getenv("SDL_AUDIODRIVER");
 
-        if (audiodriver)
+        if (audiodriver && !headless)
         {
             C_Warning(1, "The " BOLD("SDL_AUDIODRIVER") " environment variable has been set to " BOLD("\"%s\"") ".", audiodriver);
             free(audiodriver);
@@ -201,8 +254,12 @@ void S_Init(void)
         // Allocating the internal channels for mixing (the maximum number of sounds rendered simultaneously) within zone memory.
         channels = Z_Calloc(s_channels_max, sizeof(channel_t), PU_STATIC, NULL);
         sobjs = Z_Malloc(s_channels_max * sizeof(sobj_t), PU_STATIC, NULL);
+        freechannels = UINT64_MAX;
+
+        for (int i = 0; i < ORIGINHASHSIZE; i++)
+            originhash[i] = -1;
 
-        // [BH] precache all SFX
+        // check that all SFX can be played, but don't convert them until they are
         for (int i = 1; i < NUMSFX; i++)
         {
             sfxinfo_t   *sfx = &S_sfx[i];
@@ -212,11 +269,11 @@ void S_Init(void)
 
             if ((sfx->lumpnum = W_CheckNumForName(namebuf)) >= 0)
             {
-                if (!CacheSFX(sfx) && W_CheckMultipleLumps(namebuf) > 1)
+                if (!CheckSFX(sfx) && W_CheckMultipleLumps(namebuf) > 1)
                 {
                     sfx->lumpnum = W_GetLastNumForName(namebuf);
 
-                    if (!CacheSFX(sfx))
+                    if (!CheckSFX(sfx))
                         sfx->lumpnum = -1;
                     else
                     {
@@ -253,30 +310,262 @@ void S_Init(void)
 
 void S_Shutdown(void)
 {
+    // free the cached music, except what's playing, which I_ShutdownMusic() frees
+    for (int i = 0; i < MUSICCACHESIZE; i++)
+        if (musiccache[i].handle && !(mus_playing && mus_playing->handle == musiccache[i].handle))
+            Mix_FreeMusic(musiccache[i].handle);
+
     I_ShutdownSound();
     I_ShutdownMusic();
 }
 
+// Returns the lowest channel set in a mask, using a de Bruijn sequence
+static int S_LowestChannel(uint64_t mask)
+{
+    static const int    debruijn[64] =
+    {
+         0,  1, 48,  2, 57, 49, 28,  3, 61, 58, 50, 42, 38, 29, 17,  4,
+        62, 55, 59, 36, 53, 51, 43, 22, 45, 39, 33, 30, 24, 18, 12,  5,
+        63, 47, 56, 27, 60, 41, 37, 16, 54, 35, 52, 21, 44, 32, 23, 11,
+        46, 26, 40, 15, 34, 20, 31, 10, 25, 14, 19,  9, 13,  8,  7,  6
+    };
+
+    return debruijn[((mask & (~mask + 1)) * 0x03F79D71B4CB0A89ull) >> 58];
+}
+
+static dboolean S_LowerPriority(int cnum1, int cnum2)
+{
+    return (channels[cnum1].sfxinfo->priority > channels[cnum2].sfxinfo->priority);
+}
+
+static void S_SwapHeap(int i, int j)
+{
+    const int   cnum = channelheap[i];
+
+    channelheap[i] = channelheap[j];
+    channelheap[j] = cnum;
+    channels[channelheap[i]].heapindex = i;
+    channels[channelheap[j]].heapindex = j;
+}
+
+static void S_SiftHeap(int i)
+{
+    // up
+    while (i > 0 && S_LowerPriority(channelheap[i], channelheap[(i - 1) / 2]))
+    {
+        S_SwapHeap(i, (i - 1) / 2);
+        i = (i - 1) / 2;
+    }
+
+    // down
+    while (true)
+    {
+        const int   left = i * 2 + 1;
+        const int   right = left + 1;
+        int         lowest = i;
+
+        if (left < numbusychannels && S_LowerPriority(channelheap[left], channelheap[lowest]))
+            lowest = left;
+
+        if (right < numbusychannels && S_LowerPriority(channelheap[right], channelheap[lowest]))
+            lowest = right;
+
+        if (lowest == i)
+            break;
+
+        S_SwapHeap(i, lowest);
+        i = lowest;
+    }
+}
+
+static int S_OriginHash(const mobj_t *origin)
+{
+    return (int)((((uint64_t)(uintptr_t)origin >> 4) * 0x9E3779B97F4A7C15ull) >> 57);
+}
+
+static void S_LinkOrigin(int cnum)
+{
+    channel_t   *c = &channels[cnum];
+
+    if (c->origin)
+    {
+        const int   hash = S_OriginHash(c->origin);
+
+        c->nextorigin = originhash[hash];
+        originhash[hash] = cnum;
+    }
+}
+
+static void S_UnlinkOrigin(int cnum)
+{
+    channel_t   *c = &channels[cnum];
+
+    if (c->origin)
+    {
+        int *link = &originhash[S_OriginHash(c->origin)];
+
+        while (*link != cnum)
+            link = &channels[*link].nextorigin;
+
+        *link = c->nextorigin;
+    }
+}
+
+// Returns the channel playing a sound from origin with the same singularity,
+// or any sound from origin if singularity is -1, or -1 if there isn't one
+static int S_FindOriginChannel(const mobj_t *origin, int singularity)
+{
+    for (int cnum = originhash[S_OriginHash(origin)]; cnum >= 0; cnum = channels[cnum].nextorigin)
+        if (channels[cnum].origin == origin && (singularity == -1 || channels[cnum].sfxinfo->singularity == singularity))
+            return cnum;
+
+    return -1;
+}
+
 static void S_StopChannel(int cnum)
 {
     channel_t   *c = &channels[cnum];
 
     if (c->sfxinfo)
     {
+        const int   i = c->heapindex;
+
         // stop the sound playing
         if (I_SoundIsPlaying(c->handle))
             I_StopSound(c->handle);
 
-        // check to see if other channels are playing the sound
-        for (int i = 0; i < s_channels; i++)
-            if (cnum != i && c->sfxinfo == channels[i].sfxinfo)
-                break;
+        S_UnlinkOrigin(cnum);
+
+        // replace it in the heap with the last channel
+        if (i != --numbusychannels)
+        {
+            channelheap[i] = channelheap[numbusychannels];
+            channels[channelheap[i]].heapindex = i;
+            S_SiftHeap(i);
+        }
+
+        freechannels |= (1ull << cnum);
 
         c->sfxinfo = NULL;
         c->origin = NULL;
     }
 }
 
+static cachedmusic_t *S_FindCachedMusic(int lumpnum)
+{
+    for (int i = 0; i < MUSICCACHESIZE; i++)
+    {
+        cachedmusic_t   *cached = &musiccache[i];
+
+        // MUS cached as MIDI is skipped while the OPL synthesizer is used
+        if (cached->handle && cached->lumpnum == lumpnum && !(cached->musmusictype && s_oplmusic))
+        {
+            cached->lastused = ++musiccachetime;
+            return cached;
+        }
+    }
+
+    return NULL;
+}
+
+static dboolean S_IsCachedMusic(void *handle)
+{
+    if (handle)
+        for (int i = 0; i < MUSICCACHESIZE; i++)
+            if (musiccache[i].handle == handle)
+                return true;
+
+    return false;
+}
+
+static void S_CacheMusic(int lumpnum, void *handle, dboolean midi, dboolean mus)
+{
+    cachedmusic_t   *cached = NULL;
+
+    // use an empty slot, or else the least recently used song that isn't playing
+    for (int i = 0; i < MUSICCACHESIZE; i++)
+    {
+        cachedmusic_t   *slot = &musiccache[i];
+
+        if (!slot->handle)
+        {
+            cached = slot;
+            break;
+        }
+
+        if ((!mus_playing || slot->handle != mus_playing->handle) && (!cached || slot->lastused < cached->lastused))
+            cached = slot;
+    }
+
+    if (!cached)
+        return;
+
+    if (cached->handle)
+    {
+        Mix_FreeMusic(cached->handle);
+        W_ReleaseLumpNum(cached->lumpnum);
+    }
+
+    // songs may be streamed from the lump, so keep it locked while cached
+    W_CacheLumpNum(lumpnum);
+
+    cached->lumpnum = lumpnum;
+    cached->handle = handle;
+    cached->midimusictype = midi;
+    cached->musmusictype = mus;
+    cached->lastused = ++musiccachetime;
+}
+
+// Register the music in a lump, or find it in the cache
+static void *S_RegisterMusic(int lumpnum, void *data)
+{
+    cachedmusic_t   *cached = S_FindCachedMusic(lumpnum);
+    void            *handle;
+
+    if (cached)
+    {
+        midimusictype = cached->midimusictype;
+        musmusictype = cached->musmusictype;
+        oplmusictype = false;
+
+        return cached->handle;
+    }
+
+    // only songs SDL_mixer plays itself return a handle, and can be cached
+    if ((handle = I_RegisterSong(data, W_LumpLength(lumpnum))))
+        S_CacheMusic(lumpnum, handle, midimusictype, musmusictype);
+
+    return handle;
+}
+
+// Load the music in a lump ahead of time, so there's no stall when it's played
+static void S_PrecacheMusic(int lumpnum)
+{
+    void        *handle;
+    dboolean    midi;
+    dboolean    mus;
+
+    if (nomusic || lumpnum < 0 || S_FindCachedMusic(lumpnum))
+        return;
+
+    if ((handle = I_PrecacheSong(W_CacheLumpNum(lumpnum), W_LumpLength(lumpnum), &midi, &mus)))
+        S_CacheMusic(lumpnum, handle, midi, mus);
+
+    W_ReleaseLumpNum(lumpnum);
+}
+
+static int S_GetMusicLumpNum(int music_id)
+{
+    musicinfo_t *music = &S_music[music_id];
+    char        namebuf[9];
+
+    if (music->lumpnum)
+        return music->lumpnum;
+
+    M_snprintf(namebuf, sizeof(namebuf), "d_%s", music->name1);
+    return W_CheckNumForName(namebuf);
+}
+
 static int S_GetMusicNum(void)
 {
     int mnum;
@@ -340,10 +629,23 @@ static int S_GetMusicNum(void)
 //
 void S_Start(void)
 {
+    const int   map = (gameepisode - 1) * 10 + gamemap;
+    const int   nextmap = P_GetMapNext(map);
+    int         lumpnum;
+
     // start new music for the level
     mus_paused = false;
 
     S_ChangeMusic(S_GetMusicNum(), true, false, true);
+
+    // load the music for the intermission, and the next map if MAPINFO gives it
+    S_PrecacheMusic(S_GetMusicLumpNum(gamemode == commercial ? mus_dm2int : mus_inter));
+
+    if ((lumpnum = P_GetInterMusic(map)) > 0)
+        S_PrecacheMusic(lumpnum);
+
+    if (nextmap > 0 && (lumpnum = P_GetMapMusic(nextmap)) > 0)
+        S_PrecacheMusic(lumpnum);
 }
 
 // [crispy] removed map objects may finish their sounds
@@ -355,21 +657,24 @@ void S_Start(void)
 // original implementation idea: <https://www.doomworld.com/forum/topic/1585325>
 void S_UnlinkSound(mobj_t *origin)
 {
+    int cnum;
+
     if (!origin->madesound || nosfx)
         return;
 
-    for (int cnum = 0; cnum < s_channels; cnum++)
-        if (channels[cnum].sfxinfo && channels[cnum].origin == origin)
-        {
-            sobj_t  *sobj = &sobjs[cnum];
+    // every channel playing a sound from origin has to be moved, so none are left pointing to it
+    while ((cnum = S_FindOriginChannel(origin, -1)) >= 0)
+    {
+        sobj_t  *sobj = &sobjs[cnum];
 
-            sobj->x = origin->x;
-            sobj->y = origin->y;
-            sobj->z = origin->z;
-            channels[cnum].origin = (mobj_t *)sobj;
+        sobj->x = origin->x;
+        sobj->y = origin->y;
+        sobj->z = origin->z;
 
-            break;
-        }
+        S_UnlinkOrigin(cnum);
+        channels[cnum].origin = (mobj_t *)sobj;
+        S_LinkOrigin(cnum);
+    }
 }
 
 //
@@ -379,31 +684,36 @@ void S_UnlinkSound(mobj_t *origin)
 static int S_GetChannel(mobj_t *origin, sfxinfo_t *sfxinfo)
 {
     // channel number to use
-    int         cnum = 0;
+    int         cnum;
     channel_t   *c;
 
-    // Find an open channel
-    if (origin)
-        for (; cnum < s_channels && channels[cnum].sfxinfo; cnum++)
-            if (channels[cnum].origin == origin
-                && channels[cnum].sfxinfo->singularity == sfxinfo->singularity)
-            {
-                S_StopChannel(cnum);
-                break;
-            }
+    // sounds without an origin always use the first channel, cutting each other off
+    if (!origin)
+    {
+        cnum = 0;
 
-    // None available
-    if (cnum == s_channels)
+        if (channels[cnum].sfxinfo)
+            S_StopChannel(cnum);
+    }
+    else
     {
-        // Look for lower priority
-        for (cnum = 0; cnum < s_channels; cnum++)
-            if (channels[cnum].sfxinfo->priority >= sfxinfo->priority)
-                break;
+        // kill the origin's old sound
+        if ((cnum = S_FindOriginChannel(origin, sfxinfo->singularity)) >= 0)
+            S_StopChannel(cnum);
 
-        if (cnum == s_channels)
-            return -1;                  // FUCK! No lower priority. Sorry, Charlie.
-        else
-            S_StopChannel(cnum);        // Otherwise, kick out lower priority.
+        // None available
+        if (numbusychannels >= s_channels)
+        {
+            // Look for lower priority
+            cnum = channelheap[0];
+
+            if (channels[cnum].sfxinfo->priority < sfxinfo->priority)
+                return -1;              // FUCK! No lower priority. Sorry, Charlie.
+            else
+                S_StopChannel(cnum);    // Otherwise, kick out lower priority.
+        }
+
+        cnum = S_LowestChannel(freechannels);
     }
 
     c = &channels[cnum];
@@ -412,9 +722,25 @@ static int S_GetChannel(mobj_t *origin, sfxinfo_t *sfxinfo)
     c->sfxinfo = sfxinfo;
     c->origin = origin;
 
+    freechannels &= ~(1ull << cnum);
+    channelheap[numbusychannels] = cnum;
+    c->heapindex = numbusychannels++;
+    S_SiftHeap(c->heapindex);
+    S_LinkOrigin(cnum);
+
     return cnum;
 }
 
+// Returns true if the REJECT lump says that the listener can't see into the
+// sector at (x, y). Since the REJECT lump is a precomputed table of which
+// sectors are connected, this costs no more than looking up the sector.
+static dboolean S_IsOccluded(mobj_t *listener, fixed_t x, fixed_t y)
+{
+    const int   pnum = listener->subsector->sector->id * numsectors + R_PointInSubsector(x, y)->sector->id;
+
+    return (rejectmatrix[pnum >> 3] & (1 << (pnum & 7)));
+}
+
 // Changes volume and stereo-separation variables from the norm of a sound
 // effect to be played. If the sound is not audible, returns false. Otherwise,
 // modifies parameters and returns true.
@@ -465,6 +791,10 @@ static dboolean S_AdjustSoundParms(mobj_t *origin, int *vol, int *sep)
     // volume calculation
     *vol = (dist < S_CLOSE_DIST || boss ? snd_SfxVolume : snd_SfxVolume * (S_CLIPPING_DIST - dist) / S_ATTENUATOR);
 
+    // muffle sounds from sectors the listener can't see into
+    if (s_occlusion && !boss && S_IsOccluded(listener, x, y))
+        *vol /= 2;
+
     return (*vol > 0);
 }
 
@@ -483,25 +813,69 @@ static void S_StartSoundAtVolume(mobj_t *origin, int sfx_id, int pitch)
     if (origin && origin != viewplayer->mo && !S_AdjustSoundParms(origin, &volume, &sep))
         return;
 
-    // kill old sound
-    if (origin)
-        for (cnum = 0; cnum < s_channels; cnum++)
-            if (channels[cnum].sfxinfo
-                && channels[cnum].sfxinfo->singularity == sfx->singularity
-                && channels[cnum].origin == origin)
-            {
-                S_StopChannel(cnum);
-                break;
-            }
-
-    // try to find a channel
+    // try to find a channel, killing the origin's old sound
     if ((cnum = S_GetChannel(origin, sfx)) < 0)
         return;
 
     // Assigns the handle to one of the channels in the mix/output buffer.
     // e6y: [Fix] Crash with zero-length sounds.
     if ((handle = I_StartSound(sfx, cnum, volume, sep, pitch)) != -1)
-        channels[cnum].handle = handle;
+    {
+        channel_t   *c = &channels[cnum];
+
+        c->handle = handle;
+        c->volume = volume;
+        c->sep = sep;
+        c->stale = false;
+
+        if (origin)
+        {
+            c->x = origin->x;
+            c->y = origin->y;
+        }
+    }
+}
+
+//
+// S_StressChannels
+//
+// Times starting count sound effects from a small set of origins, without
+// playing them, while stopping others as they would finish in a busy map.
+// Any sound effects playing are stopped first. Returns the time taken in
+// milliseconds.
+//
+double S_StressChannels(int count)
+{
+    static degenmobj_t  origins[256];
+    unsigned int        seed = 1;
+    uint64_t            start;
+    uint64_t            elapsed;
+
+    if (nosfx)
+        return 0.0;
+
+    for (int cnum = 0; cnum < s_channels_max; cnum++)
+        S_StopChannel(cnum);
+
+    start = SDL_GetPerformanceCounter();
+
+    for (int i = 0; i < count; i++)
+    {
+        mobj_t  *origin;
+
+        seed = seed * 1103515245 + 12345;
+        origin = (mobj_t *)&origins[(seed >> 16) & 255];
+
+        if (S_GetChannel(origin, &S_sfx[1 + (seed >> 4) % (NUMSFX - 1)]) >= 0 && !(seed & 0x300))
+            S_StopChannel(channelheap[(seed >> 8) % numbusychannels]);
+    }
+
+    elapsed = SDL_GetPerformanceCounter() - start;
+
+    for (int cnum = 0; cnum < s_channels_max; cnum++)
+        S_StopChannel(cnum);
+
+    return (elapsed * 1000.0 / SDL_GetPerformanceFrequency());
 }
 
 void S_StartSound(mobj_t *mobj, int sfx_id)
@@ -544,12 +918,41 @@ void S_ResumeMusic(void)
 //
 // Updates sounds
 //
+// The listener's position, angle and the sound effects volume are checked
+// once for all channels. A channel's volume and separation are only
+// recalculated if either it or the listener has moved since the last tic,
+// and are only passed on to the mixer if they've changed.
+//
 void S_UpdateSounds(void)
 {
+    static fixed_t  listenerx;
+    static fixed_t  listenery;
+    static angle_t  listenerangle;
+    static int      listenervolume;
+    static dboolean listenerstereo;
+    static dboolean listenerocclusion;
+    mobj_t          *listener;
+    dboolean        listenermoved;
+
     if (nosfx)
         return;
 
-    for (int cnum = 0; cnum < s_channels; cnum++)
+    listener = viewplayer->mo;
+    listenermoved = (listener->x != listenerx || listener->y != listenery || viewangle != listenerangle
+        || snd_SfxVolume != listenervolume || s_stereo != listenerstereo || s_occlusion != listenerocclusion);
+
+    if (listenermoved)
+    {
+        listenerx = listener->x;
+        listenery = listener->y;
+        listenerangle = viewangle;
+        listenervolume = snd_SfxVolume;
+        listenerstereo = s_stereo;
+        listenerocclusion = s_occlusion;
+    }
+
+    // channels above s_channels may still be busy if it was lowered
+    for (int cnum = 0; cnum < s_channels_max; cnum++)
     {
         channel_t   *c = &channels[cnum];
 
@@ -559,19 +962,35 @@ void S_UpdateSounds(void)
             mobj_t  *origin = c->origin;
 
             // check non-local sounds for distance clipping or modify their parms
-            if (origin && origin != viewplayer->mo)
+            if (origin && origin != listener)
             {
                 int         sep = NORM_SEP;
                 int         volume = snd_SfxVolume;
-                sfxinfo_t   *sfx = c->sfxinfo;
 
-                if (!sfx)
+                if (!c->sfxinfo)
+                    continue;
+
+                // nothing has moved, so nothing has changed
+                if (!listenermoved && !c->stale && origin->x == c->x && origin->y == c->y)
                     continue;
 
+                c->x = origin->x;
+                c->y = origin->y;
+
                 if (!S_AdjustSoundParms(origin, &volume, &sep))
                     S_StopChannel(cnum);
+                else if (volume != c->volume || sep != c->sep)
+                {
+                    // if the audio thread's command queue is full, leave the volume and separation
+                    // as they were, so that they're updated next tic
+                    if ((c->stale = !I_UpdateSoundParms(c->handle, volume, sep)))
+                        continue;
+
+                    c->volume = volume;
+                    c->sep = sep;
+                }
                 else
-                    I_UpdateSoundParms(c->handle, volume, sep);
+                    c->stale = false;
             }
         }
         else
@@ -649,7 +1068,7 @@ void S_ChangeMusic(int music_id, dboolean looping, dboolean allowrestart, dboole
     // Load & register it
     music->data = W_CacheLumpNum(music->lumpnum);
 
-    if (!(handle = I_RegisterSong(music->data, W_LumpLength(music->lumpnum))))
+    if (!(handle = S_RegisterMusic(music->lumpnum, music->data)) && !oplmusictype)
 #if defined(_WIN32)
         if (!serverMidiPlaying)
 #endif
@@ -698,7 +1117,10 @@ void S_StopMusic(void)
         I_ResumeSong();
 
     I_StopSong();
-    I_UnRegisterSong(mus_playing->handle);
+
+    if (!S_IsCachedMusic(mus_playing->handle))
+        I_UnRegisterSong(mus_playing->handle);
+
     W_ReleaseLumpNum(mus_playing->lumpnum);
     mus_playing->data = NULL;
     mus_playing = NULL;
@@ -727,10 +1149,10 @@ void S_ChangeMusInfoMusic(int lumpnum, int looping)
 
     // load & register it
     music->data = W_CacheLumpNum(music->lumpnum);
-    music->handle = I_RegisterSong(music->data, W_LumpLength(music->lumpnum));
+    music->handle = S_RegisterMusic(music->lumpnum, music->data);
 
     // play it
-    I_PlaySong(music->handle, looping);
+    I_FadeInSong(music->handle, looping, MUSINFOFADETIME);
 
     mus_playing = music;
 
@@ -776,7 +1198,7 @@ void S_ParseMusInfo(char *mapid)
                     if (lumpnum >= 0)
                     {
                         musinfo.items[num] = lumpnum;
-                        W_CacheLumpNum(lumpnum);
+                        S_PrecacheMusic(lumpnum);
                     }
                 }
             }
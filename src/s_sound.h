@@ -57,20 +57,26 @@
 
 dboolean I_InitSound(void);
 void I_ShutdownSound(void);
-dboolean CacheSFX(sfxinfo_t *sfxinfo);
-void I_UpdateSoundParms(int channel, int vol, int sep);
+dboolean CheckSFX(sfxinfo_t *sfxinfo);
+dboolean I_UpdateSoundParms(int channel, int vol, int sep);
 int I_StartSound(sfxinfo_t *sfxinfo, int channel, int vol, int sep, int pitch);
 void I_StopSound(int channel);
 dboolean I_SoundIsPlaying(int channel);
 
+extern size_t   sfxcachebytes;
+extern int      sfxcachehits;
+extern int      sfxcachemisses;
+
 dboolean I_InitMusic(void);
 void I_ShutdownMusic(void);
 void I_SetMusicVolume(int volume);
 void I_PauseSong(void);
 void I_ResumeSong(void);
 void *I_RegisterSong(void *data, int size);
+void *I_PrecacheSong(void *data, int size, dboolean *midi, dboolean *mus);
 void I_UnRegisterSong(void *handle);
 void I_PlaySong(void *handle, dboolean looping);
+void I_FadeInSong(void *handle, dboolean looping, int ms);
 void I_StopSong(void);
 dboolean I_AnySoundStillPlaying(void);
 
@@ -98,6 +104,7 @@ void S_Start(void);
 void S_StartSound(mobj_t *mobj, int sfx_id);
 void S_StartSectorSound(degenmobj_t *degenmobj, int sfx_id);
 void S_UnlinkSound(mobj_t *origin);
+double S_StressChannels(int count);
 
 // Start music using <music_id> from sounds.h
 void S_StartMusic(int music_id);
@@ -39,6 +39,9 @@
 #if defined(_WIN32)
 #include <windows.h>
 #include <stdlib.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
 #endif
 
 #include "m_misc.h"
@@ -110,6 +113,45 @@ int D_mkdir(const char *dirname)
 }
 #endif
 
+// Map the entire file into memory so that lumps can be used directly from the
+// mapping rather than being read into a separate buffer. The mapping is
+// copy-on-write, so any lump that is patched in place only costs the pages
+// that are actually written to, and the file itself is never modified.
+static void W_MapFile(wadfile_t *wad)
+{
+#if defined(_WIN32)
+    HANDLE          file = (HANDLE)_get_osfhandle(_fileno(wad->fstream));
+    LARGE_INTEGER   size;
+    HANDLE          mapping;
+
+    if (file == INVALID_HANDLE_VALUE || !GetFileSizeEx(file, &size) || !size.QuadPart || size.HighPart)
+        return;
+
+    if (!(mapping = CreateFileMapping(file, NULL, PAGE_WRITECOPY, 0, 0, NULL)))
+        return;
+
+    // the view keeps the mapping object alive
+    if ((wad->mapping = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0)))
+        wad->mappingsize = (size_t)size.LowPart;
+
+    CloseHandle(mapping);
+#else
+    struct stat buffer;
+    void        *mapping;
+
+    if (fstat(fileno(wad->fstream), &buffer) || buffer.st_size <= 0)
+        return;
+
+    mapping = mmap(NULL, buffer.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fileno(wad->fstream), 0);
+
+    if (mapping != MAP_FAILED)
+    {
+        wad->mapping = mapping;
+        wad->mappingsize = (size_t)buffer.st_size;
+    }
+#endif
+}
+
 wadfile_t *W_OpenFile(char *path)
 {
     wadfile_t   *result;
@@ -121,12 +163,25 @@ wadfile_t *W_OpenFile(char *path)
     // Create a new wadfile_t to hold the file handle.
     result = Z_Malloc(sizeof(wadfile_t), PU_STATIC, NULL);
     result->fstream = fstream;
+    result->mapping = NULL;
+    result->mappingsize = 0;
+
+    W_MapFile(result);
 
     return result;
 }
 
 void W_CloseFile(wadfile_t *wad)
 {
+    if (wad->mapping)
+    {
+#if defined(_WIN32)
+        UnmapViewOfFile(wad->mapping);
+#else
+        munmap(wad->mapping, wad->mappingsize);
+#endif
+    }
+
     fclose(wad->fstream);
     Z_Free(wad);
 }
@@ -135,6 +190,20 @@ void W_CloseFile(wadfile_t *wad)
 // provided buffer. Returns the number of bytes read.
 size_t W_Read(wadfile_t *wad, unsigned int offset, void *buffer, size_t buffer_len)
 {
+    if (wad->mapping)
+    {
+        // Copy straight out of the mapping.
+        if (offset >= wad->mappingsize)
+            return 0;
+
+        if (buffer_len > wad->mappingsize - offset)
+            buffer_len = wad->mappingsize - offset;
+
+        memcpy(buffer, wad->mapping + offset, buffer_len);
+
+        return buffer_len;
+    }
+
     // Jump to the specified position in the file.
     fseek(wad->fstream, offset, SEEK_SET);
 
@@ -142,6 +211,19 @@ size_t W_Read(wadfile_t *wad, unsigned int offset, void *buffer, size_t buffer_l
     return fread(buffer, 1, buffer_len, wad->fstream);
 }
 
+// Returns a pointer to the specified range of the file if it is mapped
+// into memory, or NULL if it must be read using W_Read() instead. Lumps are
+// cast to structs of shorts and ints, so a range that isn't aligned for them
+// must be read into an aligned buffer, too.
+void *W_MapLump(wadfile_t *wad, unsigned int offset, size_t length)
+{
+    if (!wad->mapping || offset > wad->mappingsize || length > wad->mappingsize - offset
+        || (offset & (sizeof(int) - 1)))
+        return NULL;
+
+    return (wad->mapping + offset);
+}
+
 dboolean W_WriteFile(char const *name, const void *source, size_t length)
 {
     FILE    *fstream = fopen(name, "wb");
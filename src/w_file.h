@@ -72,10 +72,12 @@ typedef struct wadfile_s wadfile_t;
 
 struct wadfile_s
 {
-    FILE        *fstream;
-    dboolean    freedoom;
-    char        path[MAX_PATH];
-    int         type;
+    FILE            *fstream;
+    unsigned char   *mapping;
+    size_t          mappingsize;
+    dboolean        freedoom;
+    char            path[MAX_PATH];
+    int             type;
 };
 
 // Open the specified file. Returns a pointer to a new wadfile_t
@@ -90,6 +92,10 @@ void W_CloseFile(wadfile_t *wad);
 // Returns the number of bytes read.
 size_t W_Read(wadfile_t *wad, unsigned int offset, void *buffer, size_t buffer_len);
 
+// Returns a pointer directly into the memory-mapped file for the
+// specified range, or NULL if the file isn't mapped.
+void *W_MapLump(wadfile_t *wad, unsigned int offset, size_t length);
+
 dboolean W_WriteFile(char const *name, const void *source, size_t length);
 
 #endif
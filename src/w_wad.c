@@ -45,9 +45,11 @@
 #include "doomstat.h"
 #include "i_swap.h"
 #include "i_system.h"
+#include "i_timer.h"
 #include "m_misc.h"
 #include "w_merge.h"
 #include "w_wad.h"
+#include "w_zip.h"
 #include "z_zone.h"
 
 #define MAXWADS 16
@@ -78,10 +80,30 @@ typedef struct
 // Location of each lump on disk.
 lumpinfo_t  **lumpinfo;
 int         numlumps;
+int         maxlumps;
 
 static int          numwads;
 static wadfile_t    *wadlist[MAXWADS];
 
+// Total size of all lumps currently cached directly from memory-mapped WADs
+static size_t       mappedlumpsize;
+
+int                 lumpcachehits;
+int                 lumpcachemisses;
+
+// Open-addressed hash table of the last lump with each name. The other lumps
+// with the same name are chained in descending order through next.
+static int          *lumphash;
+static int          lumphashmask;
+static dboolean     lumphashvalid;
+
+// Lumps are allocated from large blocks that are never moved or freed, so
+// pointers to them stay valid as more files are added and merged.
+#define LUMPBLOCKSIZE   4096
+
+static lumpinfo_t   *lumpblock;
+static int          lumpblockfree;
+
 extern char *packagewad;
 
 static dboolean IsFreedoom(const char *iwadname)
@@ -270,6 +292,46 @@ char *W_NearestFilename(char *path, char *string)
 }
 #endif
 
+//
+// W_AllocLumps
+// Allocate count contiguous, zeroed lumps from the current block.
+//
+lumpinfo_t *W_AllocLumps(int count)
+{
+    lumpinfo_t  *lumps;
+
+    if (count > lumpblockfree)
+    {
+        // start a new block, abandoning whatever is left of the last one
+        lumpblockfree = MAX(count, LUMPBLOCKSIZE);
+
+        if (!(lumpblock = calloc(lumpblockfree, sizeof(lumpinfo_t))))
+            I_Error("W_AllocLumps: Unable to allocate %i lumps.", count);
+    }
+
+    lumps = lumpblock;
+    lumpblock += count;
+    lumpblockfree -= count;
+
+    return lumps;
+}
+
+//
+// W_AddLumps
+// Append lumps to the lump directory, doubling its size when it's full.
+//
+static void W_AddLumps(lumpinfo_t *lumps, int count)
+{
+    if (numlumps + count > maxlumps)
+    {
+        maxlumps = MAX(numlumps + count, maxlumps * 2);
+        lumpinfo = I_Realloc(lumpinfo, maxlumps * sizeof(*lumpinfo));
+    }
+
+    for (int i = 0; i < count; i++)
+        lumpinfo[numlumps++] = &lumps[i];
+}
+
 //
 // LUMP BASED ROUTINES.
 //
@@ -287,11 +349,13 @@ dboolean W_AddFile(char *filename, dboolean automatic)
     wadinfo_t       header;
     size_t          length;
     int             startlump;
+    dboolean        mapped;
     filelump_t      *fileinfo;
     filelump_t      *filerover;
     lumpinfo_t      *filelumps;
     char            *temp;
     char            *file = leafname(filename);
+    const int       parsetime = I_GetTimeMS();
 
     // open the file and add to directory
     wadfile_t       *wadfile = W_OpenFile(filename);
@@ -304,58 +368,86 @@ dboolean W_AddFile(char *filename, dboolean automatic)
 
     M_StringCopy(wadfile->path, GetCorrectCase(filename), sizeof(wadfile->path));
 
-    if ((wadfile->freedoom = IsFreedoom(filename)))
-        FREEDOOM = true;
-
-    // WAD file
     W_Read(wadfile, 0, &header, sizeof(header));
 
-    // Homebrew levels?
-    if (strncmp(header.id, "IWAD", 4) && strncmp(header.id, "PWAD", 4))
-        I_Error("%s doesn't have an IWAD or PWAD id.", filename);
+    startlump = numlumps;
 
-    if (!strncmp(header.id, "IWAD", 4) || D_IsDOOMIWAD(file))
+    // PK3 file
+    if (W_IsZipFile(header.id))
     {
-        wadfile->type = IWAD;
-        bfgedition = IsBFGEdition(filename);
+        int count;
+
+        if (!(filelumps = W_ZipLumps(wadfile, &count)))
+            I_Error("%s is an invalid PK3 file.", filename);
+
+        wadfile->type = PWAD;
+        W_AddLumps(filelumps, count);
     }
     else
-        wadfile->type = PWAD;
+    {
+        if ((wadfile->freedoom = IsFreedoom(filename)))
+            FREEDOOM = true;
 
-    header.numlumps = LONG(header.numlumps);
-    header.infotableofs = LONG(header.infotableofs);
-    length = header.numlumps * sizeof(filelump_t);
-    fileinfo = malloc(length);
-    W_Read(wadfile, header.infotableofs, fileinfo, length);
+        // Homebrew levels?
+        if (strncmp(header.id, "IWAD", 4) && strncmp(header.id, "PWAD", 4))
+            I_Error("%s doesn't have an IWAD or PWAD id.", filename);
 
-    // Increase size of numlumps array to accommodate the new file.
-    filelumps = calloc(header.numlumps, sizeof(lumpinfo_t));
+        if (!strncmp(header.id, "IWAD", 4) || D_IsDOOMIWAD(file))
+        {
+            wadfile->type = IWAD;
+            bfgedition = IsBFGEdition(filename);
+        }
+        else
+            wadfile->type = PWAD;
 
-    startlump = numlumps;
-    numlumps += header.numlumps;
-    lumpinfo = I_Realloc(lumpinfo, numlumps * sizeof(lumpinfo_t *));
-    filerover = fileinfo;
+        header.numlumps = LONG(header.numlumps);
+        header.infotableofs = LONG(header.infotableofs);
+        length = header.numlumps * sizeof(filelump_t);
 
-    for (int i = startlump; i < numlumps; i++)
-    {
-        lumpinfo_t  *lump_p = &filelumps[i - startlump];
-
-        lump_p->wadfile = wadfile;
-        lump_p->position = LONG(filerover->filepos);
-        lump_p->size = LONG(filerover->size);
-        lump_p->cache = NULL;
-        strncpy(lump_p->name, filerover->name, 8);
-        lumpinfo[i] = lump_p;
-        filerover++;
-    }
+        // parse the directory straight from the mapped file if possible
+        if ((fileinfo = W_MapLump(wadfile, header.infotableofs, length)))
+            mapped = true;
+        else
+        {
+            mapped = false;
+            fileinfo = malloc(length);
+            W_Read(wadfile, header.infotableofs, fileinfo, length);
+        }
 
-    free(fileinfo);
+        filelumps = W_AllocLumps(header.numlumps);
+        filerover = fileinfo;
+
+        for (int i = 0; i < header.numlumps; i++)
+        {
+            lumpinfo_t  *lump_p = &filelumps[i];
+
+            lump_p->wadfile = wadfile;
+            lump_p->position = LONG(filerover->filepos);
+            lump_p->size = LONG(filerover->size);
+            strncpy(lump_p->name, filerover->name, 8);
+            filerover++;
+        }
+
+        if (!mapped)
+            free(fileinfo);
+
+        W_AddLumps(filelumps, header.numlumps);
+    }
 
     temp = commify((int64_t)numlumps - startlump);
     C_Output("%s %s lump%s from the %s " BOLD("%s") ".", (automatic ? "Automatically added" : "Added"), temp,
-        (numlumps - startlump == 1 ? "" : "s"), (wadfile->type == IWAD ? "IWAD" : "PWAD"), wadfile->path);
+        (numlumps - startlump == 1 ? "" : "s"), (wadfile->type == IWAD ? "IWAD" : (W_IsZipFile(header.id) ? "PK3" : "PWAD")),
+        wadfile->path);
     free(temp);
 
+    if (devparm)
+        C_Output("The directory of " BOLD("%s") " was parsed in %i ms.", file, I_GetTimeMS() - parsetime);
+
+    for (int i = startlump; i < numlumps; i++)
+        lumpinfo[i]->key = W_LumpNameKey(lumpinfo[i]->name);
+
+    lumphashvalid = false;
+
     if (M_StringCompare(file, "SIGIL_v1_21.wad")
         || M_StringCompare(file, "SIGIL_v1_2.wad")
         || M_StringCompare(file, "SIGIL_v1_1.wad")
@@ -418,7 +510,7 @@ dboolean HasDehackedLump(const char *pwadname)
         return false;
 
     // read IWAD header
-    if (fread(&header, 1, sizeof(header), fp) == sizeof(header))
+    if (fread(&header, 1, sizeof(header), fp) == sizeof(header) && !W_IsZipFile(header.id))
     {
         fseek(fp, LONG(header.infotableofs), SEEK_SET);
 
@@ -444,8 +536,12 @@ GameMission_t IWADRequiredByPWAD(char *pwadname)
     else
     {
         wadinfo_t   header;
+        size_t      length = fread(&header, 1, sizeof(header), fp);
 
-        if (fread(&header, 1, sizeof(header), fp) != sizeof(header)
+        // PK3s don't require a particular IWAD
+        if (length == sizeof(header) && W_IsZipFile(header.id))
+            fclose(fp);
+        else if (length != sizeof(header)
             || (header.id[0] != 'I' && header.id[0] != 'P') || header.id[1] != 'W' || header.id[2] != 'A' || header.id[3] != 'D')
         {
             fclose(fp);
@@ -499,12 +595,80 @@ int W_WadType(char *filename)
 
     if (!strncmp(header.id, "IWAD", 4) || M_StringEndsWith(filename, "DOOM2.WAD"))
         return IWAD;
-    else if (!strncmp(header.id, "PWAD", 4))
+    else if (!strncmp(header.id, "PWAD", 4) || W_IsZipFile(header.id))
         return PWAD;
     else
         return 0;
 }
 
+//
+// W_LumpNameKey
+// Pack a lump name into an uppercase 64-bit key, so that lump names can be
+// compared with a single integer compare.
+//
+uint64_t W_LumpNameKey(const char *name)
+{
+    uint64_t    key = 0;
+
+    for (int i = 0; i < 8 && name[i]; i++)
+        key |= (uint64_t)toupper((unsigned char)name[i]) << (i * 8);
+
+    return key;
+}
+
+static int W_LumpKeySlot(uint64_t key)
+{
+    int slot = (int)((key * 0x9E3779B97F4A7C15ull) >> 40) & lumphashmask;
+    int i;
+
+    while ((i = lumphash[slot]) >= 0 && lumpinfo[i]->key != key)
+        slot = (slot + 1) & lumphashmask;
+
+    return slot;
+}
+
+//
+// W_Init
+// (Re)build the lump name hash table. This is called again whenever a
+// name is looked up after more files have been added, since merging files
+// reorders the lumps.
+//
+void W_Init(void)
+{
+    int size = 1;
+
+    // keep the table no more than half full
+    while (size < numlumps * 2)
+        size <<= 1;
+
+    lumphash = I_Realloc(lumphash, size * sizeof(*lumphash));
+    lumphashmask = size - 1;
+
+    for (int i = 0; i < size; i++)
+        lumphash[i] = -1;
+
+    // Insert lumps in first-to-last order, so the last lump with a given name
+    // is the one in the table, observing pwad ordering rules. killough
+    for (int i = 0; i < numlumps; i++)
+    {
+        const int   slot = W_LumpKeySlot(lumpinfo[i]->key);
+
+        lumpinfo[i]->next = lumphash[slot];
+        lumphash[slot] = i;
+    }
+
+    lumphashvalid = true;
+}
+
+// Returns the last lump with the given name, or -1 if there isn't one
+static int W_LastLumpWithName(const char *name)
+{
+    if (!lumphashvalid)
+        W_Init();
+
+    return lumphash[W_LumpKeySlot(W_LumpNameKey(name))];
+}
+
 //
 // W_CheckNumForName
 // Returns -1 if name not found.
@@ -513,24 +677,12 @@ int W_WadType(char *filename)
 // cuts down on time -- increases DOOM performance over 300%. This is the
 // single most important optimization of the original DOOM sources, because
 // lump name lookup is used so often, and the original DOOM used a sequential
-// search. For large wads with > 1000 lumps this meant an average of over
-// 500 were probed during every search. Now the average is under 2 probes per
-// search. There is no significant benefit to packing the names into longwords
-// with this new hashing algorithm, because the work to do the packing is
-// just as much work as simply doing the string comparisons with the new
-// algorithm, which minimizes the expected number of comparisons to under 2.
+// search. Lump names are now packed into 64-bit keys when they're added, so
+// each probe is a single integer compare.
 //
 int W_CheckNumForName(const char *name)
 {
-    // Hash function maps the name to one of possibly numlump chains.
-    // It has been tuned so that the average chain length never exceeds 2.
-    int i = lumpinfo[W_LumpNameHash(name) % numlumps]->index;
-
-    while (i >= 0 && strncasecmp(lumpinfo[i]->name, name, 8))
-        i = lumpinfo[i]->next;
-
-    // Return the matching lump, or -1 if none found.
-    return i;
+    return W_LastLumpWithName(name);
 }
 
 //
@@ -544,42 +696,26 @@ int W_CheckMultipleLumps(const char *name)
     if (FREEDOOM || hacx)
         return 3;
 
-    for (int i = numlumps - 1; i >= 0; i--)
-        if (!strncasecmp(lumpinfo[i]->name, name, 8))
-            count++;
+    for (int i = W_LastLumpWithName(name); i >= 0; i = lumpinfo[i]->next)
+        count++;
 
     return count;
 }
 
 //
 // W_RangeCheckNumForName
-// Linear Search that checks for a lump number ONLY inside a range, not all lumps.
+// Checks for a lump number ONLY inside a range, not all lumps.
 //
 int W_RangeCheckNumForName(int min, int max, const char *name)
 {
-    for (int i = min; i <= max; i++)
-        if (!strncasecmp(lumpinfo[i]->name, name, 8))
-            return i;
+    int result = -1;
 
-    return -1;
-}
+    // lumps with the same name are chained from last to first
+    for (int i = W_LastLumpWithName(name); i >= min; i = lumpinfo[i]->next)
+        if (i <= max)
+            result = i;
 
-void W_Init(void)
-{
-    for (int i = 0; i < numlumps; i++)
-        lumpinfo[i]->index = -1;                       // mark slots empty
-
-    // Insert nodes to the beginning of each chain, in first-to-last
-    // lump order, so that the last lump of a given name appears first
-    // in any chain, observing pwad ordering rules. killough
-    for (int i = 0; i < numlumps; i++)
-    {
-        // hash function:
-        int j = W_LumpNameHash(lumpinfo[i]->name) % numlumps;
-
-        lumpinfo[i]->next = lumpinfo[j]->index;       // Prepend to list
-        lumpinfo[j]->index = i;
-    }
+    return result;
 }
 
 //
@@ -599,31 +735,32 @@ int W_GetNumForName(const char *name)
 // Go forwards rather than backwards so we get lump from IWAD and not PWAD
 int W_GetLastNumForName(const char *name)
 {
-    int i;
-
-    for (i = 0; i < numlumps; i++)
-        if (!strncasecmp(lumpinfo[i]->name, name, 8))
-            break;
+    int i = W_LastLumpWithName(name);
 
-    if (i == numlumps)
+    if (i < 0)
         I_Error("W_GetLastNumForName: %s not found!", name);
 
+    while (lumpinfo[i]->next >= 0)
+        i = lumpinfo[i]->next;
+
     return i;
 }
 
 int W_GetSecondNumForName(const char *name)
 {
-    int count = 0;
-    int i;
+    int first = -1;
+    int second = -1;
 
-    for (i = 0; i < numlumps; i++)
-        if (!strncasecmp(lumpinfo[i]->name, name, 8) && ++count == 2)
-            break;
+    for (int i = W_LastLumpWithName(name); i >= 0; i = lumpinfo[i]->next)
+    {
+        second = first;
+        first = i;
+    }
 
-    if (i == numlumps)
+    if (second < 0)
         I_Error("W_GetSecondNumForName: %s not found!", name);
 
-    return i;
+    return second;
 }
 
 //
@@ -650,23 +787,133 @@ static void W_ReadLump(int lump, void *dest)
     if (!l->size || !dest)
         return;
 
-    if ((c = W_Read(l->wadfile, l->position, dest, l->size)) < (size_t)l->size)
+    if (l->compressed)
+    {
+        // inflate straight from the mapping if possible
+        const byte  *source = W_MapLump(l->wadfile, l->position, l->compressedsize);
+        byte        *buffer = NULL;
+
+        if (!source)
+        {
+            source = buffer = malloc(l->compressedsize);
+
+            if ((c = W_Read(l->wadfile, l->position, buffer, l->compressedsize)) < (size_t)l->compressedsize)
+                I_Error("W_ReadLump: only read %zd of %i on lump %i", c, l->compressedsize, lump);
+        }
+
+        if (!W_Inflate(dest, l->size, source, l->compressedsize))
+            I_Error("W_ReadLump: unable to decompress lump %i", lump);
+
+        free(buffer);
+    }
+    else if ((c = W_Read(l->wadfile, l->position, dest, l->size)) < (size_t)l->size)
         I_Error("W_ReadLump: only read %zd of %i on lump %i", c, l->size, lump);
 }
 
+//
+// W_CacheLumpNum
+// Lumps in a memory-mapped WAD are returned directly from the mapping,
+// otherwise they are read into a PU_CACHE zone buffer. Once every
+// W_CacheLumpNum of the lump has been matched by a W_ReleaseLumpNum, that
+// buffer joins the most recently used end of PU_RELEASED, which is kept
+// within the cachesize CVAR. Caching a released lump again takes it back out.
+//
 void *W_CacheLumpNum(int lumpnum)
 {
     lumpinfo_t  *lump = lumpinfo[lumpnum];
 
+    // lumps that are cached every frame and never released stay locked
+    if (lump->locks < INT_MAX)
+        lump->locks++;
+
+    if (!lump->cache)
+    {
+        lumpcachemisses++;
+
+        if (lump->size && !lump->compressed && (lump->cache = W_MapLump(lump->wadfile, lump->position, lump->size)))
+        {
+            lump->mapped = true;
+            mappedlumpsize += lump->size;
+        }
+        else
+            W_ReadLump(lumpnum, Z_Malloc(lump->size, PU_CACHE, &lump->cache));
+    }
+    else
+    {
+        lumpcachehits++;
+
+        if (!lump->mapped)
+            Z_ChangeTag(lump->cache, PU_CACHE);
+    }
+
+    return lump->cache;
+}
+
+//
+// W_CacheLumpNumWritable
+// As W_CacheLumpNum, but always reads the lump into its own zone buffer so
+// that it can be modified in place.
+//
+void *W_CacheLumpNumWritable(int lumpnum)
+{
+    lumpinfo_t  *lump = lumpinfo[lumpnum];
+
+    if (lump->locks < INT_MAX)
+        lump->locks++;
+
+    if (lump->mapped)
+    {
+        lump->cache = NULL;
+        lump->mapped = false;
+        mappedlumpsize -= lump->size;
+    }
+
     if (!lump->cache)
         W_ReadLump(lumpnum, Z_Malloc(lump->size, PU_CACHE, &lump->cache));
+    else
+        Z_ChangeTag(lump->cache, PU_CACHE);
 
     return lump->cache;
 }
 
+//
+// W_PrefetchLumpNum
+// Cache a lump ahead of when it's needed. If it's in a memory-mapped WAD,
+// touch each page of it so it's read from disk now.
+//
+void W_PrefetchLumpNum(int lumpnum)
+{
+    lumpinfo_t      *lump = lumpinfo[lumpnum];
+    volatile byte   *data = W_CacheLumpNum(lumpnum);
+
+    if (lump->mapped)
+        for (int i = 0; i < lump->size; i += 4096)
+            (void)data[i];
+
+    // let it be purged to stay within the cachesize CVAR until it's cached again
+    W_ReleaseLumpNum(lumpnum);
+}
+
 void W_ReleaseLumpNum(int lumpnum)
 {
-    Z_ChangeTag(lumpinfo[lumpnum]->cache, PU_CACHE);
+    lumpinfo_t  *lump = lumpinfo[lumpnum];
+
+    if (lump->locks <= 0 || lump->locks == INT_MAX || --lump->locks)
+        return;
+
+    // lumps in a mapped WAD aren't zone memory
+    if (!lump->mapped)
+        Z_ChangeTag(lump->cache, PU_RELEASED);
+}
+
+//
+// W_MappedLumpSize
+// Returns the number of bytes of lump data that are being used directly from
+// memory-mapped WADs rather than being copied into the zone.
+//
+size_t W_MappedLumpSize(void)
+{
+    return mappedlumpsize;
 }
 
 void W_CloseFiles(void)
@@ -60,17 +60,31 @@ struct lumpinfo_s
     int         size;
     void        *cache;
 
-    // killough 01/31/98: hash table fields, used for ultra-fast hash table lookup
-    int         index;
+    // number of times the lump has been cached but not released
+    int         locks;
+
+    // uppercase name packed into 64 bits, and the previous lump with the same
+    // name, used for ultra-fast hash table lookup
+    uint64_t    key;
     int         next;
 
     int         position;
 
     wadfile_t   *wadfile;
+
+    // lump is cached directly from a memory-mapped WAD
+    dboolean    mapped;
+
+    // lump is deflated in a PK3
+    dboolean    compressed;
+    int         compressedsize;
 };
 
 extern lumpinfo_t   **lumpinfo;
 extern int          numlumps;
+extern int          maxlumps;
+extern int          lumpcachehits;
+extern int          lumpcachemisses;
 
 dboolean IsUltimateDOOM(const char *iwadname);
 
@@ -82,6 +96,7 @@ char *W_NearestFilename(char *path, char *string);
 
 dboolean W_AddFile(char *filename, dboolean automatic);
 int W_WadType(char *filename);
+lumpinfo_t *W_AllocLumps(int count);
 
 int W_CheckNumForName(const char *name);
 
@@ -95,6 +110,8 @@ int W_CheckMultipleLumps(const char *name);
 int W_LumpLength(int lump);
 
 void *W_CacheLumpNum(int lumpnum);
+void *W_CacheLumpNumWritable(int lumpnum);
+void W_PrefetchLumpNum(int lumpnum);
 
 #define W_CacheLumpName(name)       W_CacheLumpNum(W_GetNumForName(name))
 #define W_CacheSecondLumpName(name) W_CacheLumpNum(W_GetSecondNumForName(name))
@@ -103,11 +120,14 @@ void *W_CacheLumpNum(int lumpnum);
 void W_Init(void);
 
 unsigned int W_LumpNameHash(const char *s);
+uint64_t W_LumpNameKey(const char *name);
 
 void W_ReleaseLumpNum(int lumpnum);
 
 #define W_ReleaseLumpName(name)     W_ReleaseLumpNum(W_GetNumForName(name))
 
+size_t W_MappedLumpSize(void);
+
 void W_CloseFiles(void);
 
 GameMission_t IWADRequiredByPWAD(char *pwadname);
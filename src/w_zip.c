@@ -0,0 +1,688 @@
+/*
+========================================================================
+
+                           D O O M  R e t r o
+         The classic, refined DOOM source port. For Windows PC.
+
+========================================================================
+
+  Copyright © 1993-2021 by id Software LLC, a ZeniMax Media company.
+  Copyright © 2013-2021 by Brad Harding <mailto:brad@doomretro.com>.
+
+  DOOM Retro is a fork of Chocolate DOOM. For a list of credits, see
+  <https://github.com/bradharding/doomretro/wiki/CREDITS>.
+
+  This file is a part of DOOM Retro.
+
+  DOOM Retro is free software: you can redistribute it and/or modify it
+  under the terms of the GNU General Public License as published by the
+  Free Software Foundation, either version 3 of the License, or (at your
+  option) any later version.
+
+  DOOM Retro is distributed in the hope that it will be useful, but
+  WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with DOOM Retro. If not, see <https://www.gnu.org/licenses/>.
+
+  DOOM is a registered trademark of id Software LLC, a ZeniMax Media
+  company, in the US and/or other countries, and is used without
+  permission. All other trademarks are the property of their respective
+  holders. DOOM Retro is in no way affiliated with nor endorsed by
+  id Software.
+
+========================================================================
+*/
+
+#include <ctype.h>
+#include <string.h>
+
+#include "c_console.h"
+#include "i_system.h"
+#include "m_misc.h"
+#include "w_zip.h"
+
+#define ZIP_LOCALSIG        0x04034B50
+#define ZIP_CENTRALSIG      0x02014B50
+#define ZIP_ENDSIG          0x06054B50
+
+#define ZIP_LOCALSIZE       30
+#define ZIP_CENTRALSIZE     46
+#define ZIP_ENDSIZE         22
+#define ZIP_MAXCOMMENT      65535
+
+#define ZIP_STORED          0
+#define ZIP_DEFLATED        8
+#define ZIP_ENCRYPTED       1
+
+typedef enum
+{
+    NAMESPACE_GLOBAL,
+    NAMESPACE_PATCHES,
+    NAMESPACE_FLATS,
+    NAMESPACE_SPRITES,
+    NUMNAMESPACES,
+    NAMESPACE_IGNORED
+} namespace_t;
+
+// The directories in a PK3 that are mapped onto the marker ranges that
+// W_MergeFile() already understands in a PWAD
+static const struct
+{
+    char        *folder;
+    namespace_t ns;
+} folders[] =
+{
+    { "sprites",  NAMESPACE_SPRITES },
+    { "flats",    NAMESPACE_FLATS   },
+    { "patches",  NAMESPACE_PATCHES },
+    { "sounds",   NAMESPACE_GLOBAL  },
+    { "music",    NAMESPACE_GLOBAL  },
+    { "graphics", NAMESPACE_GLOBAL  },
+    { "",         NAMESPACE_IGNORED }
+};
+
+static const char *startmarkers[NUMNAMESPACES] = { "", "P_START", "F_START", "S_START" };
+static const char *endmarkers[NUMNAMESPACES] = { "", "P_END", "F_END", "S_END" };
+
+static unsigned int ZipShort(const byte *p)
+{
+    return (p[0] | (p[1] << 8));
+}
+
+static unsigned int ZipLong(const byte *p)
+{
+    return (p[0] | (p[1] << 8) | (p[2] << 16) | ((unsigned int)p[3] << 24));
+}
+
+dboolean W_IsZipFile(const char *id)
+{
+    return (id[0] == 'P' && id[1] == 'K' && id[2] == 3 && id[3] == 4);
+}
+
+static size_t ZipFileSize(wadfile_t *wadfile)
+{
+    long    size;
+
+    if (wadfile->mapping)
+        return wadfile->mappingsize;
+
+    fseek(wadfile->fstream, 0, SEEK_END);
+    size = ftell(wadfile->fstream);
+
+    return (size > 0 ? (size_t)size : 0);
+}
+
+// Find which namespace a file in the PK3 belongs to from its path, and
+// get its lump name. Returns NAMESPACE_IGNORED if it can't be used.
+static namespace_t ZipNamespace(const char *path, int length, char *name)
+{
+    const char  *leaf = path;
+    const char  *ext = NULL;
+    namespace_t ns = NAMESPACE_GLOBAL;
+    int         len;
+
+    for (int i = 0; i < length; i++)
+        if (path[i] == '/')
+        {
+            if (leaf == path)
+            {
+                // the first folder in the path determines the namespace
+                int j = 0;
+
+                while (*folders[j].folder
+                    && ((int)strlen(folders[j].folder) != i || strncasecmp(path, folders[j].folder, i)))
+                    j++;
+
+                ns = folders[j].ns;
+            }
+
+            leaf = path + i + 1;
+        }
+        else if (path[i] == '.')
+            ext = path + i;
+
+    if (!ext || ext < leaf)
+        ext = path + length;
+
+    if ((len = (int)(ext - leaf)) < 1 || len > 8)
+        return NAMESPACE_IGNORED;
+
+    for (int i = 0; i < len; i++)
+        name[i] = toupper(leaf[i]);
+
+    name[len] = '\0';
+
+    return ns;
+}
+
+lumpinfo_t *W_ZipLumps(wadfile_t *wadfile, int *count)
+{
+    size_t          filesize = ZipFileSize(wadfile);
+    size_t          taillen = (filesize < ZIP_ENDSIZE + ZIP_MAXCOMMENT ? filesize : ZIP_ENDSIZE + ZIP_MAXCOMMENT);
+    byte            *tail;
+    byte            *end = NULL;
+    byte            *directory;
+    byte            *entry;
+    unsigned int    numentries;
+    unsigned int    directorysize;
+    unsigned int    directorypos;
+    lumpinfo_t      *entries;
+    namespace_t     *namespaces;
+    lumpinfo_t      *lumps;
+    int             numlumps = 0;
+    int             nscount[NUMNAMESPACES] = { 0 };
+    int             ignored = 0;
+
+    if (taillen < ZIP_ENDSIZE)
+        return NULL;
+
+    // find the end of central directory record, which is followed by a
+    // comment of up to 64KB
+    tail = malloc(taillen);
+
+    if (W_Read(wadfile, (unsigned int)(filesize - taillen), tail, taillen) < taillen)
+    {
+        free(tail);
+        return NULL;
+    }
+
+    for (byte *p = tail + taillen - ZIP_ENDSIZE; p >= tail; p--)
+        if (ZipLong(p) == ZIP_ENDSIG)
+        {
+            end = p;
+            break;
+        }
+
+    if (!end)
+    {
+        free(tail);
+        return NULL;
+    }
+
+    numentries = ZipShort(end + 10);
+    directorysize = ZipLong(end + 12);
+    directorypos = ZipLong(end + 16);
+    free(tail);
+
+    if ((size_t)directorypos + directorysize > filesize)
+        return NULL;
+
+    directory = malloc(directorysize);
+
+    if (W_Read(wadfile, directorypos, directory, directorysize) < directorysize)
+    {
+        free(directory);
+        return NULL;
+    }
+
+    entries = calloc(numentries, sizeof(lumpinfo_t));
+    namespaces = malloc(numentries * sizeof(namespace_t));
+    entry = directory;
+
+    for (unsigned int i = 0; i < numentries; i++)
+    {
+        lumpinfo_t      *lump = &entries[i];
+        unsigned int    namelength;
+        unsigned int    method;
+        unsigned int    compressedsize;
+        unsigned int    size;
+        byte            local[ZIP_LOCALSIZE];
+
+        if (entry + ZIP_CENTRALSIZE > directory + directorysize || ZipLong(entry) != ZIP_CENTRALSIG)
+        {
+            free(directory);
+            free(entries);
+            free(namespaces);
+            return NULL;
+        }
+
+        namelength = ZipShort(entry + 28);
+        method = ZipShort(entry + 10);
+        compressedsize = ZipLong(entry + 20);
+        size = ZipLong(entry + 24);
+        namespaces[i] = NAMESPACE_IGNORED;
+
+        if (entry + ZIP_CENTRALSIZE + namelength <= directory + directorysize
+            && (namelength && entry[ZIP_CENTRALSIZE + namelength - 1] != '/'))
+        {
+            if ((ZipShort(entry + 8) & ZIP_ENCRYPTED) || (method != ZIP_STORED && method != ZIP_DEFLATED)
+                || size > INT_MAX || compressedsize > INT_MAX
+                || (namespaces[i] = ZipNamespace((char *)entry + ZIP_CENTRALSIZE, namelength, lump->name)) == NAMESPACE_IGNORED)
+                ignored++;
+            else
+            {
+                // the data follows the local header, whose name and extra
+                // fields can differ in length from the central directory's
+                unsigned int    localpos = ZipLong(entry + 42);
+
+                if (W_Read(wadfile, localpos, local, ZIP_LOCALSIZE) < ZIP_LOCALSIZE || ZipLong(local) != ZIP_LOCALSIG)
+                {
+                    namespaces[i] = NAMESPACE_IGNORED;
+                    ignored++;
+                }
+                else
+                {
+                    lump->wadfile = wadfile;
+                    lump->position = localpos + ZIP_LOCALSIZE + ZipShort(local + 26) + ZipShort(local + 28);
+                    lump->size = size;
+                    lump->compressedsize = compressedsize;
+                    lump->compressed = (method == ZIP_DEFLATED);
+                    nscount[namespaces[i]]++;
+                    numlumps++;
+                }
+            }
+        }
+
+        entry += ZIP_CENTRALSIZE + namelength + ZipShort(entry + 30) + ZipShort(entry + 32);
+    }
+
+    free(directory);
+
+    if (ignored)
+    {
+        char    *temp = commify(ignored);
+
+        C_Warning(1, "%s file%s in " BOLD("%s") " will be ignored.", temp, (ignored == 1 ? "" : "s"), leafname(wadfile->path));
+        free(temp);
+    }
+
+    // global lumps first, then each namespace between its markers
+    for (int ns = NAMESPACE_PATCHES; ns < NUMNAMESPACES; ns++)
+        if (nscount[ns])
+            numlumps += 2;
+
+    lumps = W_AllocLumps(numlumps);
+    *count = 0;
+
+    for (int ns = NAMESPACE_GLOBAL; ns < NUMNAMESPACES; ns++)
+    {
+        if (!nscount[ns])
+            continue;
+
+        if (ns != NAMESPACE_GLOBAL)
+        {
+            lumps[*count].wadfile = wadfile;
+            M_StringCopy(lumps[(*count)++].name, startmarkers[ns], sizeof(lumps[0].name));
+        }
+
+        for (unsigned int i = 0; i < numentries; i++)
+            if (namespaces[i] == (namespace_t)ns)
+                lumps[(*count)++] = entries[i];
+
+        if (ns != NAMESPACE_GLOBAL)
+        {
+            lumps[*count].wadfile = wadfile;
+            M_StringCopy(lumps[(*count)++].name, endmarkers[ns], sizeof(lumps[0].name));
+        }
+    }
+
+    free(entries);
+    free(namespaces);
+
+    return lumps;
+}
+
+//
+// Inflate
+// A small decoder for raw DEFLATE streams (RFC 1951), used to decompress
+// lumps in PK3 files. Based on puff by Mark Adler.
+//
+#define MAXBITS     15
+#define MAXLCODES   286
+#define MAXDCODES   30
+#define MAXCODES    (MAXLCODES + MAXDCODES)
+#define FIXLCODES   288
+
+typedef struct
+{
+    const byte  *in;
+    size_t      inlen;
+    size_t      incnt;
+    int         bitbuf;
+    int         bitcnt;
+    byte        *out;
+    size_t      outlen;
+    size_t      outcnt;
+    dboolean    error;
+} inflatestate_t;
+
+typedef struct
+{
+    short       *count;
+    short       *symbol;
+} huffman_t;
+
+static const short  lbase[29] =
+{
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+};
+
+static const short  lext[29] =
+{
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+};
+
+static const short  dbase[30] =
+{
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073,
+    4097, 6145, 8193, 12289, 16385, 24577
+};
+
+static const short  dext[30] =
+{
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+};
+
+static int Bits(inflatestate_t *s, int need)
+{
+    int val = s->bitbuf;
+
+    while (s->bitcnt < need)
+    {
+        if (s->incnt == s->inlen)
+        {
+            s->error = true;
+            return 0;
+        }
+
+        val |= s->in[s->incnt++] << s->bitcnt;
+        s->bitcnt += 8;
+    }
+
+    s->bitbuf = val >> need;
+    s->bitcnt -= need;
+
+    return (val & ((1 << need) - 1));
+}
+
+static dboolean Stored(inflatestate_t *s)
+{
+    unsigned int    len;
+
+    // discard leftover bits from the current byte
+    s->bitbuf = 0;
+    s->bitcnt = 0;
+
+    if (s->incnt + 4 > s->inlen)
+        return false;
+
+    len = s->in[s->incnt] | (s->in[s->incnt + 1] << 8);
+
+    if (s->in[s->incnt + 2] != (~len & 0xFF) || s->in[s->incnt + 3] != ((~len >> 8) & 0xFF))
+        return false;
+
+    s->incnt += 4;
+
+    if (s->incnt + len > s->inlen || s->outcnt + len > s->outlen)
+        return false;
+
+    memcpy(s->out + s->outcnt, s->in + s->incnt, len);
+    s->incnt += len;
+    s->outcnt += len;
+
+    return true;
+}
+
+static int Decode(inflatestate_t *s, const huffman_t *h)
+{
+    int code = 0;
+    int first = 0;
+    int index = 0;
+
+    for (int len = 1; len <= MAXBITS; len++)
+    {
+        int count;
+
+        code |= Bits(s, 1);
+        count = h->count[len];
+
+        if (code - count < first)
+            return h->symbol[index + (code - first)];
+
+        index += count;
+        first = (first + count) << 1;
+        code <<= 1;
+    }
+
+    return -1;
+}
+
+// Build a canonical Huffman decoding table from the code lengths. Returns
+// 0 for a complete code, a positive number for an incomplete one and a
+// negative number if the code is over-subscribed.
+static int Construct(huffman_t *h, const short *length, int n)
+{
+    short   offs[MAXBITS + 1];
+    int     left = 1;
+
+    for (int len = 0; len <= MAXBITS; len++)
+        h->count[len] = 0;
+
+    for (int symbol = 0; symbol < n; symbol++)
+        h->count[length[symbol]]++;
+
+    if (h->count[0] == n)
+        return 0;
+
+    for (int len = 1; len <= MAXBITS; len++)
+    {
+        left <<= 1;
+
+        if ((left -= h->count[len]) < 0)
+            return left;
+    }
+
+    offs[1] = 0;
+
+    for (int len = 1; len < MAXBITS; len++)
+        offs[len + 1] = offs[len] + h->count[len];
+
+    for (int symbol = 0; symbol < n; symbol++)
+        if (length[symbol])
+            h->symbol[offs[length[symbol]]++] = symbol;
+
+    return left;
+}
+
+static dboolean Codes(inflatestate_t *s, const huffman_t *lencode, const huffman_t *distcode)
+{
+    int symbol;
+
+    do
+    {
+        if ((symbol = Decode(s, lencode)) < 0 || s->error)
+            return false;
+
+        if (symbol < 256)
+        {
+            if (s->outcnt == s->outlen)
+                return false;
+
+            s->out[s->outcnt++] = symbol;
+        }
+        else if (symbol > 256)
+        {
+            size_t  len;
+            size_t  dist;
+
+            if ((symbol -= 257) >= 29)
+                return false;
+
+            len = lbase[symbol] + Bits(s, lext[symbol]);
+
+            if ((symbol = Decode(s, distcode)) < 0 || symbol >= 30)
+                return false;
+
+            dist = dbase[symbol] + Bits(s, dext[symbol]);
+
+            if (s->error || dist > s->outcnt || s->outcnt + len > s->outlen)
+                return false;
+
+            while (len--)
+            {
+                s->out[s->outcnt] = s->out[s->outcnt - dist];
+                s->outcnt++;
+            }
+        }
+    } while (symbol != 256);
+
+    return true;
+}
+
+static dboolean Fixed(inflatestate_t *s)
+{
+    static dboolean     built;
+    static short        lencnt[MAXBITS + 1];
+    static short        lensym[FIXLCODES];
+    static short        distcnt[MAXBITS + 1];
+    static short        distsym[MAXDCODES];
+    static huffman_t    lencode = { lencnt, lensym };
+    static huffman_t    distcode = { distcnt, distsym };
+
+    if (!built)
+    {
+        short   lengths[FIXLCODES];
+        int     symbol;
+
+        for (symbol = 0; symbol < 144; symbol++)
+            lengths[symbol] = 8;
+
+        for (; symbol < 256; symbol++)
+            lengths[symbol] = 9;
+
+        for (; symbol < 280; symbol++)
+            lengths[symbol] = 7;
+
+        for (; symbol < FIXLCODES; symbol++)
+            lengths[symbol] = 8;
+
+        Construct(&lencode, lengths, FIXLCODES);
+
+        for (symbol = 0; symbol < MAXDCODES; symbol++)
+            lengths[symbol] = 5;
+
+        Construct(&distcode, lengths, MAXDCODES);
+        built = true;
+    }
+
+    return Codes(s, &lencode, &distcode);
+}
+
+static dboolean Dynamic(inflatestate_t *s)
+{
+    static const short  order[19] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+    short               lengths[MAXCODES];
+    short               lencnt[MAXBITS + 1];
+    short               lensym[MAXLCODES];
+    short               distcnt[MAXBITS + 1];
+    short               distsym[MAXDCODES];
+    huffman_t           lencode = { lencnt, lensym };
+    huffman_t           distcode = { distcnt, distsym };
+    int                 nlen = Bits(s, 5) + 257;
+    int                 ndist = Bits(s, 5) + 1;
+    int                 ncode = Bits(s, 4) + 4;
+    int                 index;
+    int                 err;
+
+    if (s->error || nlen > MAXLCODES || ndist > MAXDCODES)
+        return false;
+
+    // read the code length code lengths
+    for (index = 0; index < ncode; index++)
+        lengths[order[index]] = Bits(s, 3);
+
+    for (; index < 19; index++)
+        lengths[order[index]] = 0;
+
+    if (s->error || Construct(&lencode, lengths, 19))
+        return false;
+
+    // read the literal/length and distance code lengths
+    index = 0;
+
+    while (index < nlen + ndist)
+    {
+        int symbol = Decode(s, &lencode);
+
+        if (symbol < 0 || s->error)
+            return false;
+
+        if (symbol < 16)
+            lengths[index++] = symbol;
+        else
+        {
+            short   len = 0;
+
+            if (symbol == 16)
+            {
+                if (!index)
+                    return false;
+
+                len = lengths[index - 1];
+                symbol = 3 + Bits(s, 2);
+            }
+            else if (symbol == 17)
+                symbol = 3 + Bits(s, 3);
+            else
+                symbol = 11 + Bits(s, 7);
+
+            if (s->error || index + symbol > nlen + ndist)
+                return false;
+
+            while (symbol--)
+                lengths[index++] = len;
+        }
+    }
+
+    // there must be an end-of-block code
+    if (!lengths[256])
+        return false;
+
+    // incomplete codes are only allowed if they have a single length
+    if ((err = Construct(&lencode, lengths, nlen)) && (err < 0 || nlen != lencode.count[0] + lencode.count[1]))
+        return false;
+
+    if ((err = Construct(&distcode, lengths + nlen, ndist)) && (err < 0 || ndist != distcode.count[0] + distcode.count[1]))
+        return false;
+
+    return Codes(s, &lencode, &distcode);
+}
+
+dboolean W_Inflate(byte *dest, size_t destlen, const byte *source, size_t sourcelen)
+{
+    inflatestate_t  s = { source, sourcelen, 0, 0, 0, dest, destlen, 0, false };
+    int             last;
+
+    do
+    {
+        dboolean    result;
+
+        last = Bits(&s, 1);
+
+        switch (Bits(&s, 2))
+        {
+            case 0:
+                result = Stored(&s);
+                break;
+
+            case 1:
+                result = Fixed(&s);
+                break;
+
+            case 2:
+                result = Dynamic(&s);
+                break;
+
+            default:
+                return false;
+        }
+
+        if (!result || s.error)
+            return false;
+    } while (!last);
+
+    return (s.outcnt == destlen);
+}
@@ -1016,6 +1016,9 @@ void WI_Ticker(void)
 
     WI_LoadData();
 
+    // read in the next map a lump at a time
+    P_PrefetchLevelLump();
+
     WI_CheckForAccelerate();
 
     switch (state)
@@ -1242,4 +1245,6 @@ void WI_Start(wbstartstruct_t *wbstartstruct)
     WI_InitVariables(wbstartstruct);
 
     WI_InitStats();
+
+    P_PrefetchLevel(wbstartstruct->epsd + 1, wbstartstruct->next + 1);
 }
@@ -37,6 +37,7 @@
 */
 
 #include "i_system.h"
+#include "m_config.h"
 #include "z_zone.h"
 
 // Minimum chunk size at which blocks are allocated
@@ -58,6 +59,56 @@ static const size_t headersize = (sizeof(memblock_t) + CHUNK_SIZE - 1) & ~(CHUNK
 
 static memblock_t   *blockbytag[PU_MAX];
 
+zonestats_t         zonestats[PU_MAX];
+
+// Maximum size in MB of the PU_RELEASED blocks that are kept (0 for no limit)
+int                 cachesize = cachesize_default;
+
+static void Z_AddStats(int tag, size_t size)
+{
+    zonestats_t *stats = &zonestats[tag];
+
+    if ((stats->bytes += size) > stats->peakbytes)
+        stats->peakbytes = stats->bytes;
+
+    if (++stats->blocks > stats->peakblocks)
+        stats->peakblocks = stats->blocks;
+}
+
+static void Z_RemoveStats(int tag, size_t size)
+{
+    zonestats[tag].bytes -= size;
+    zonestats[tag].blocks--;
+}
+
+//
+// Z_PurgeBlock
+// Free the least recently used block with a purgeable tag. Blocks are appended
+// to their tag's list when they're allocated or retagged, so this is always
+// the first block in the list.
+//
+static void Z_PurgeBlock(int tag)
+{
+    Z_Free((char *)blockbytag[tag] + headersize);
+    zonestats[tag].purges++;
+}
+
+//
+// Z_TrimCache
+// Purge the least recently used PU_RELEASED blocks until they fit within the
+// cachesize CVAR, but never the block that was just added.
+//
+static void Z_TrimCache(void)
+{
+    const size_t    budget = (size_t)cachesize * 1024 * 1024;
+
+    if (!cachesize)
+        return;
+
+    while (zonestats[PU_RELEASED].bytes > budget && blockbytag[PU_RELEASED] != blockbytag[PU_RELEASED]->prev)
+        Z_PurgeBlock(PU_RELEASED);
+}
+
 //
 // Z_Malloc
 // You can pass a NULL user if the tag is < PU_PURGELEVEL.
@@ -79,12 +130,15 @@ void *Z_Malloc(size_t size, int tag, void **user)
 
     size = (size + CHUNK_SIZE - 1) & ~(CHUNK_SIZE - 1); // round to chunk size
 
+    // purge released blocks first, and only then those that may still be in use
     while (!(block = malloc(size + headersize)))
     {
-        if (!blockbytag[PU_CACHE])
+        if (blockbytag[PU_RELEASED])
+            Z_PurgeBlock(PU_RELEASED);
+        else if (blockbytag[PU_CACHE])
+            Z_PurgeBlock(PU_CACHE);
+        else
             I_Error("Z_Malloc: Failure trying to allocate %lu bytes", (unsigned long)size);
-
-        Z_FreeTags(PU_CACHE, PU_CACHE);
     }
 
     if (!blockbytag[tag])
@@ -101,6 +155,7 @@ void *Z_Malloc(size_t size, int tag, void **user)
     }
 
     block->size = size;
+    Z_AddStats(tag, size);
 
     block->tag = tag;                                   // tag
     block->user = user;                                 // user
@@ -109,6 +164,9 @@ void *Z_Malloc(size_t size, int tag, void **user)
     if (user)                                           // if there is a user
         *user = block;                                  // set user to point to new block
 
+    if (tag == PU_RELEASED)
+        Z_TrimCache();
+
     return block;
 }
 
@@ -132,9 +190,15 @@ void Z_Free(void *ptr)
     block->prev->next = block->next;
     block->next->prev = block->prev;
 
+    Z_RemoveStats(block->tag, block->size);
     free(block);
 }
 
+//
+// Z_FreeTags
+// Free every block with a tag from lowtag to hightag. Each tag's blocks are
+// freed in bulk, without unlinking them from the list one at a time.
+//
 void Z_FreeTags(int lowtag, int hightag)
 {
     if (lowtag <= PU_FREE)
@@ -152,18 +216,26 @@ void Z_FreeTags(int lowtag, int hightag)
             continue;
 
         end_block = block->prev;
+        blockbytag[lowtag] = NULL;
 
         while (true)
         {
             memblock_t  *next = block->next;
+            dboolean    last = (block == end_block);
+
+            if (block->user)                            // Nullify user if one exists
+                *block->user = NULL;
 
-            Z_Free((char *)block + headersize);
+            free(block);
 
-            if (block == end_block)
+            if (last)
                 break;
 
             block = next;                               // Advance to next block
         }
+
+        zonestats[lowtag].bytes = 0;
+        zonestats[lowtag].blocks = 0;
     }
 }
 
@@ -188,6 +260,9 @@ void Z_ChangeTag(void *ptr, int tag)
     block->prev->next = block->next;
     block->next->prev = block->prev;
 
+    Z_RemoveStats(block->tag, block->size);
+    Z_AddStats(tag, block->size);
+
     if (!blockbytag[tag])
     {
         blockbytag[tag] = block;
@@ -202,4 +277,7 @@ void Z_ChangeTag(void *ptr, int tag)
     }
 
     block->tag = tag;
+
+    if (tag == PU_RELEASED)
+        Z_TrimCache();
 }
@@ -54,12 +54,24 @@ enum
     PU_STATIC,     // static entire execution time
     PU_LEVEL,      // static until level exited
     PU_LEVSPEC,    // a special thinker in a level
-    PU_CACHE,
+    PU_CACHE,      // purgeable when memory runs out
+    PU_RELEASED,   // purgeable, and kept within the cachesize CVAR
     PU_MAX         // Must always be last -- killough
 };
 
 #define PU_PURGELEVEL    PU_CACHE    // First purgeable tag's level
 
+typedef struct
+{
+    size_t  bytes;          // bytes currently allocated with this tag
+    int     blocks;         // number of blocks currently allocated
+    size_t  peakbytes;      // high-water mark of bytes
+    int     peakblocks;     // high-water mark of blocks
+    int     purges;         // blocks purged to make room for others
+} zonestats_t;
+
+extern zonestats_t  zonestats[PU_MAX];
+
 void *Z_Malloc(size_t size, int tag, void **user);
 void *Z_Calloc(size_t n1, size_t n2, int tag, void **user);
 void Z_Free(void *ptr);